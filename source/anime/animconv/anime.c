@@ -49,6 +49,68 @@ typedef struct AnimeWork
 
 #define EXEC_LEVEL GV_ACTOR_AFTER
 
+#ifdef DEV_EXE
+// fits the one and two vertex puffs (blood mist, smoke, muzzle flashes)
+#define ANIME_POOL_SIZE (sizeof(AnimeWork) + (sizeof(AnimeItem) + sizeof(SVECTOR)) * 2)
+
+STATIC long    anime_pool_buf[64][(ANIME_POOL_SIZE + 3) / 4];
+STATIC GV_POOL anime_pool = GV_POOL_INIT(anime_pool_buf);
+
+STATIC void anime_Free(void *work)
+{
+    GV_FreePoolActor(&anime_pool, work);
+}
+
+/*
+ * Script interpreter counters. With anime_vm_stats set, print how many
+ * vertex steps ran the script (counter expired) against those that only
+ * moved the vertex, and how often each opcode ran. The figures cover
+ * ANIME_VM_FRAMES game frames (GV_Time) and are printed by the first
+ * anime_Act after that, so frames without an anime still count.
+ */
+#define ANIME_VM_FRAMES 300
+
+int anime_vm_stats;
+
+STATIC int anime_vm_steps;
+STATIC int anime_vm_runs;
+STATIC int anime_vm_ops[16];   /* the opcode is checked against 15 before it is counted */
+STATIC int anime_vm_start;
+
+STATIC void anime_vm_report(void)
+{
+    int i;
+
+    printf("--anime vm %d frames: steps %d script %d--\n",
+           GV_Time - anime_vm_start, anime_vm_steps, anime_vm_runs);
+
+    for (i = 1; i < 16; i++)
+    {
+        printf(" op%d %d", i, anime_vm_ops[i]);
+        anime_vm_ops[i] = 0;
+    }
+    printf("\n");
+
+    anime_vm_steps = 0;
+    anime_vm_runs = 0;
+    anime_vm_start = GV_Time;
+}
+
+STATIC void anime_vm_frame(void)
+{
+    // the window opens at the first step counted, and again if GV_Time was reset
+    if (anime_vm_steps == 0 || GV_Time < anime_vm_start)
+    {
+        anime_vm_start = GV_Time;
+    }
+
+    if (GV_Time - anime_vm_start >= ANIME_VM_FRAMES)
+    {
+        anime_vm_report();
+    }
+}
+#endif
+
 /*---------------------------------------------------------------------------*/
 
 typedef int (*TAnimeVMFn)(AnimeWork *, int);
@@ -1201,11 +1263,25 @@ STATIC void anime_Act(AnimeWork *work)
     item = work->items;
     DG_VisiblePrim(work->prim);
 
+#ifdef DEV_EXE
+    if (anime_vm_stats)
+    {
+        anime_vm_frame();
+        anime_vm_steps += work->n_vertices;
+    }
+#endif
+
     vertices = work->vertices;
     for (i = 0; i < work->n_vertices; ++i)
     {
         if (item->counter <= 0)
         {
+#ifdef DEV_EXE
+            if (anime_vm_stats)
+            {
+                anime_vm_runs++;
+            }
+#endif
             while (1)
             {
                 script_op_code = *item->op_code & 0x7F;
@@ -1215,6 +1291,12 @@ STATIC void anime_Act(AnimeWork *work)
                     GV_DestroyActor(&work->actor);
                     break;
                 }
+#ifdef DEV_EXE
+                if (anime_vm_stats)
+                {
+                    anime_vm_ops[script_op_code]++;
+                }
+#endif
                 opCodeRet = anime_fn_table_8009F228[script_op_code - 1](work, i);
                 if (opCodeRet)
                 {
@@ -1418,7 +1500,12 @@ void *NewAnime(MATRIX *world, int map, ANIMATION *animation)
     AnimeWork *work;
 
     count = animation->n_vertices;
+#ifdef DEV_EXE
+    work = GV_NewPoolActor(&anime_pool, EXEC_LEVEL,
+                           ((sizeof(AnimeItem) + sizeof(SVECTOR)) * count) + sizeof(AnimeWork), anime_Free);
+#else
     work = GV_NewActor(EXEC_LEVEL, ((sizeof(AnimeItem) + sizeof(SVECTOR)) * count) + sizeof(AnimeWork));
+#endif
     if (work)
     {
         work->vertices = (SVECTOR *)&work->items[count]; // count vectors after the items
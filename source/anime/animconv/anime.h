@@ -32,6 +32,10 @@ typedef struct ANIMATION
     char          *field_18_ptr;
 } ANIMATION;
 
+#ifdef DEV_EXE
+extern int anime_vm_stats;
+#endif
+
 void *NewAnime(MATRIX *world, int map, ANIMATION *animation);
 void *NewAnime2(DG_PRIM *prim, int map, ANIMATION *animation);
 
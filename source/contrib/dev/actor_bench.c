@@ -0,0 +1,249 @@
+/*
+ * Actor scheduling benchmark (dev only).
+ *
+ * Set actor_bench_request to a number of actors and the next
+ * GV_ExecActorSystem call builds that many synthetic actors with GV_Malloc,
+ * then times two ways of running them:
+ *
+ *   list   the GV_ExecActorSystem walk over a linked ActorList
+ *   table  a dense array of { act, self } pairs
+ *
+ * Both clear GM_CurrentMap after every call, as GV_ExecActorSystem does.
+ * The walk is repeated until ACTOR_BENCH_CALLS acts have run, and the cost
+ * is printed in hsyncs per 1000 acts. If the heap runs out, the benchmark
+ * runs with as many actors as it could allocate.
+ *
+ * actor_bench_pool = N creates and destroys N effect-sized actors, in bursts
+ * of ACTOR_BENCH_BURST as a firefight would, once with GV_NewActor and once
+ * with GV_NewPoolActor.
+ */
+#ifdef DEV_EXE
+
+#include <stdio.h>
+#include <libapi.h>
+#include "common.h"
+#include "libgv/libgv.h"
+
+#define ACTOR_BENCH_CALLS   20000
+#define ACTOR_BENCH_BURST   16
+#define ACTOR_BENCH_SIZE    0x100
+
+typedef struct
+{
+    GV_ACTFUNC act;
+    GV_ACT    *self;
+} ACTOR_BENCH_SLOT;
+
+int actor_bench_request;
+int actor_bench_pool;
+
+STATIC int actor_bench_acts;
+
+STATIC long    actor_bench_pool_buf[ACTOR_BENCH_BURST][ACTOR_BENCH_SIZE / 4];
+STATIC GV_POOL actor_bench_pool_ctl = GV_POOL_INIT(actor_bench_pool_buf);
+
+static void actor_bench_pool_free(void *actor)
+{
+    GV_FreePoolActor(&actor_bench_pool_ctl, actor);
+}
+
+static void actor_bench_act(GV_ACT *actor)
+{
+    actor_bench_acts++;
+}
+
+static int actor_bench_list(ActorList *lp)
+{
+    extern int GM_CurrentMap;
+
+    GV_ACT *actor;
+    GV_ACT *current;
+    GV_ACT *next;
+    long    intime, outtime;
+
+    intime = GetRCnt(RCntCNT1);
+
+    actor = &lp->first;
+    for (;;)
+    {
+        current = actor;
+        next = current->next;
+        if (current->act)
+        {
+            current->act(current);
+        }
+
+        GM_CurrentMap = 0;
+        actor = next;
+        if (!next)
+        {
+            break;
+        }
+    }
+
+    outtime = GetRCnt(RCntCNT1);
+    return (outtime - intime) & 0xffff;
+}
+
+static int actor_bench_table(ACTOR_BENCH_SLOT *table, int count)
+{
+    extern int GM_CurrentMap;
+
+    ACTOR_BENCH_SLOT *slot;
+    long              intime, outtime;
+    int               i;
+
+    intime = GetRCnt(RCntCNT1);
+
+    slot = table;
+    for (i = count; i > 0; i--, slot++)
+    {
+        slot->act(slot->self);
+        GM_CurrentMap = 0;
+    }
+
+    outtime = GetRCnt(RCntCNT1);
+    return (outtime - intime) & 0xffff;
+}
+
+static void actor_bench_print(const char *name, int hsyncs, int acts)
+{
+    if (acts == 0)
+    {
+        acts = 1;
+    }
+
+    printf(" %s %d.%02d", name, (hsyncs * 1000) / acts, (((hsyncs * 1000) % acts) * 100) / acts);
+}
+
+void GV_ActorBench(void)
+{
+    ActorList         list;
+    ACTOR_BENCH_SLOT *table;
+    GV_ACT           *actor;
+    GV_ACT           *next;
+    int               request, count;
+    int               reps, rep;
+    int               list_hsyncs, table_hsyncs;
+
+    request = actor_bench_request;
+    actor_bench_request = 0;
+
+    table = GV_Malloc(request * sizeof(ACTOR_BENCH_SLOT));
+    if (!table)
+    {
+        printf("actor_bench: no memory for %d actors\n", request);
+        return;
+    }
+
+    list.first.prev = NULL;
+    list.first.next = &list.last;
+    list.first.act = NULL;
+    list.last.prev = &list.first;
+    list.last.next = NULL;
+    list.last.act = NULL;
+
+    // same insertion as GV_InitActor, into a list of our own
+    for (count = 0; count < request; count++)
+    {
+        actor = GV_Malloc(sizeof(GV_ACT));
+        if (!actor)
+        {
+            break;
+        }
+
+        actor->prev = list.last.prev;
+        actor->next = &list.last;
+        list.last.prev->next = actor;
+        list.last.prev = actor;
+        actor->act = actor_bench_act;
+
+        table[count].act = actor_bench_act;
+        table[count].self = actor;
+    }
+
+    reps = (count > 0) ? (ACTOR_BENCH_CALLS + count - 1) / count : 0;
+
+    list_hsyncs = 0;
+    table_hsyncs = 0;
+    actor_bench_acts = 0;
+
+    for (rep = reps; rep > 0; rep--)
+    {
+        list_hsyncs += actor_bench_list(&list);
+        table_hsyncs += actor_bench_table(table, count);
+    }
+
+    printf("actor_bench %d actors (%d requested), %d acts:", count,
+           request, actor_bench_acts);
+    actor_bench_print("list", list_hsyncs, reps * count);
+    actor_bench_print("table", table_hsyncs, reps * count);
+    printf(" hsync/1000 acts\n");
+
+    for (actor = list.first.next; actor != &list.last; actor = next)
+    {
+        next = actor->next;
+        GV_Free(actor);
+    }
+
+    GV_Free(table);
+}
+
+/* Returns the hsyncs taken to create and destroy 'count' actors. */
+static int actor_bench_alloc(int count, int pool)
+{
+    GV_ACT *burst[ACTOR_BENCH_BURST];
+    long    intime, outtime;
+    int     hsyncs;
+    int     n, i;
+
+    hsyncs = 0;
+
+    for (; count > 0; count -= n)
+    {
+        n = (count < ACTOR_BENCH_BURST) ? count : ACTOR_BENCH_BURST;
+
+        intime = GetRCnt(RCntCNT1);
+
+        for (i = 0; i < n; i++)
+        {
+            if (pool)
+            {
+                burst[i] = GV_NewPoolActor(&actor_bench_pool_ctl, GV_ACTOR_AFTER,
+                                           ACTOR_BENCH_SIZE, actor_bench_pool_free);
+            }
+            else
+            {
+                burst[i] = GV_NewActor(GV_ACTOR_AFTER, ACTOR_BENCH_SIZE);
+            }
+        }
+
+        for (i = 0; i < n; i++)
+        {
+            if (burst[i])
+            {
+                GV_DestroyActorQuick(burst[i]);
+            }
+        }
+
+        outtime = GetRCnt(RCntCNT1);
+        hsyncs += (outtime - intime) & 0xffff;
+    }
+
+    return hsyncs;
+}
+
+void GV_ActorBenchPool(void)
+{
+    int count;
+
+    count = actor_bench_pool;
+    actor_bench_pool = 0;
+
+    printf("actor_bench %d allocs:", count);
+    actor_bench_print("heap", actor_bench_alloc(count, 0), count);
+    actor_bench_print("pool", actor_bench_alloc(count, 1), count);
+    printf(" hsync/1000 allocs, %d misses\n", actor_bench_pool_ctl.misses);
+}
+
+#endif // DEV_EXE
@@ -0,0 +1,251 @@
+/*
+ * Enemy AI profiler (dev only).
+ *
+ * EnemyActionMain runs Enemy_Think through AI_BenchThink. While
+ * ai_bench_enable is set, every think is timed per think state
+ * (think1 << 4 | think2) and the HZD queries it makes are counted from
+ * HZD_Stats. Every AI_BENCH_FRAMES frames a report is printed with the
+ * thinks per frame, HZD queries per think and thinks/s of CPU time.
+ *
+ * Only the real thinks are timed: a copy of a watcher would still share its
+ * target, actors, the enemy globals and rand(), so running one would change
+ * what the real soldiers do and break recorded and replayed play.
+ *
+ * ai_bench_route = 1 runs the alert-mode routing benchmark once: an enemy
+ * in every zone of the player's map walks HZD_LinkRoute hop by hop to the
+ * player's address, with the route cache off, cold and warm.
+ */
+#ifdef DEV_EXE
+
+#include <stdio.h>
+#include <libapi.h>
+#include "common.h"
+#include "libgv/libgv.h"
+#include "libhzd/libhzd.h"
+#include "game/game.h"
+#include "game/map.h"
+
+#define AI_BENCH_STATES     48
+#define AI_BENCH_FRAMES     300
+#define AI_BENCH_HSYNC_HZ   15734   /* RCntCNT1 counts hsyncs (NTSC) */
+#define AI_BENCH_MAX_HOPS   64
+
+typedef struct AI_BENCH_STATE
+{
+    int thinks;
+    int hsyncs;
+} AI_BENCH_STATE;
+
+int ai_bench_enable;
+int ai_bench_route;
+
+STATIC AI_BENCH_STATE ai_bench_state[AI_BENCH_STATES];
+STATIC int            ai_bench_queries[HZD_STAT_MAX];
+STATIC int            ai_bench_thinks;
+STATIC int            ai_bench_hsyncs;
+STATIC int            ai_bench_frames;
+STATIC int            ai_bench_time;
+
+/* count per second of CPU time, without overflowing on long runs */
+static int ai_bench_rate(int count, int hsyncs)
+{
+    int msec;
+
+    msec = (hsyncs * 10) / (AI_BENCH_HSYNC_HZ / 100);
+    if (msec == 0)
+    {
+        return 0;
+    }
+
+    return (count / msec) * 1000 + ((count % msec) * 1000) / msec;
+}
+
+/* prints num / den with two decimals */
+static void ai_bench_print_ratio(const char *name, int num, int den)
+{
+    if (den == 0)
+    {
+        den = 1;
+    }
+
+    printf(" %s %d.%02d", name, num / den, ((num % den) * 100) / den);
+}
+
+static void ai_bench_report(void)
+{
+    AI_BENCH_STATE *state;
+    int             i;
+
+    printf("--ai_bench %d frames--\n", ai_bench_frames);
+
+    ai_bench_print_ratio("thinks/frame", ai_bench_thinks, ai_bench_frames);
+    ai_bench_print_ratio("hsync/frame", ai_bench_hsyncs, ai_bench_frames);
+    printf(" thinks/s %d\n", ai_bench_rate(ai_bench_thinks, ai_bench_hsyncs));
+
+    printf("hzd/think");
+    ai_bench_print_ratio("addr", ai_bench_queries[HZD_STAT_ADDRESS], ai_bench_thinks);
+    ai_bench_print_ratio("reach", ai_bench_queries[HZD_STAT_REACH], ai_bench_thinks);
+    ai_bench_print_ratio("route", ai_bench_queries[HZD_STAT_ROUTE], ai_bench_thinks);
+    ai_bench_print_ratio("nav", ai_bench_queries[HZD_STAT_NAVIGATE], ai_bench_thinks);
+    ai_bench_print_ratio("line", ai_bench_queries[HZD_STAT_LINE], ai_bench_thinks);
+    ai_bench_print_ratio("batch", ai_bench_queries[HZD_STAT_LINE_BATCH], ai_bench_thinks);
+    ai_bench_print_ratio("hop", ai_bench_queries[HZD_STAT_HOP_HIT], ai_bench_thinks);
+    ai_bench_print_ratio("hop miss", ai_bench_queries[HZD_STAT_HOP_MISS], ai_bench_thinks);
+    printf("\n");
+
+    state = ai_bench_state;
+    for (i = 0; i < AI_BENCH_STATES; i++, state++)
+    {
+        if (state->thinks == 0)
+        {
+            continue;
+        }
+
+        printf("think %d-%02d: %6d thinks", i >> 4, i & 15, state->thinks);
+        ai_bench_print_ratio("hsync", state->hsyncs, state->thinks);
+        printf("\n");
+
+        state->thinks = 0;
+        state->hsyncs = 0;
+    }
+
+    for (i = 0; i < HZD_STAT_MAX; i++)
+    {
+        ai_bench_queries[i] = 0;
+    }
+
+    ai_bench_thinks = 0;
+    ai_bench_hsyncs = 0;
+    ai_bench_frames = 0;
+}
+
+static void ai_bench_run(void *work, int state, void (*think)(void *))
+{
+    int  queries[HZD_STAT_MAX];
+    long intime, outtime;
+    int  hsyncs;
+    int  i;
+
+    for (i = 0; i < HZD_STAT_MAX; i++)
+    {
+        queries[i] = HZD_Stats[i];
+    }
+
+    intime = GetRCnt(RCntCNT1);
+    think(work);
+    outtime = GetRCnt(RCntCNT1);
+    hsyncs = (outtime - intime) & 0xffff;
+
+    for (i = 0; i < HZD_STAT_MAX; i++)
+    {
+        ai_bench_queries[i] += HZD_Stats[i] - queries[i];
+    }
+
+    ai_bench_state[state].thinks++;
+    ai_bench_state[state].hsyncs += hsyncs;
+
+    ai_bench_thinks++;
+    ai_bench_hsyncs += hsyncs;
+}
+
+/* Every zone routes to the player's address, as when the whole map is on alert. */
+static void ai_bench_route_pass(const char *name, HZD_HDL *hzd)
+{
+    SVECTOR pos;
+    long    intime, outtime;
+    int     hits, misses;
+    int     hops;
+    int     from, addr;
+    int     n;
+
+    hits = HZD_Stats[HZD_STAT_HOP_HIT];
+    misses = HZD_Stats[HZD_STAT_HOP_MISS];
+    hops = 0;
+
+    intime = GetRCnt(RCntCNT1);
+
+    for (from = 0; from < hzd->header->n_zones; from++)
+    {
+        addr = from | (from << 8);
+        pos = GM_PlayerPosition;
+
+        for (n = 0; n < AI_BENCH_MAX_HOPS; n++)
+        {
+            if (HZD_ReachTo(hzd, addr, GM_PlayerAddress) <= 1)
+            {
+                break;
+            }
+
+            addr = HZD_LinkRoute(hzd, addr, GM_PlayerAddress, &pos);
+            addr |= addr << 8;
+            hops++;
+        }
+
+        HZD_ZoneDistance(hzd, from, GM_PlayerAddress & 0xFF);
+    }
+
+    outtime = GetRCnt(RCntCNT1);
+
+    printf("route %-4s: zones %d hops %d hsync %d hit %d miss %d\n", name,
+           hzd->header->n_zones, hops, (int)((outtime - intime) & 0xffff),
+           HZD_Stats[HZD_STAT_HOP_HIT] - hits, HZD_Stats[HZD_STAT_HOP_MISS] - misses);
+}
+
+static void ai_bench_route_run(void)
+{
+    MAP *map;
+    int  old_enable;
+
+    ai_bench_route = 0;
+
+    map = GM_GetMap(GM_PlayerMap);
+    if (!map || !map->hzd || (GM_PlayerAddress & 0xFF) == HZD_NO_ZONE)
+    {
+        printf("ai_bench: no player address\n");
+        return;
+    }
+
+    old_enable = HZD_RouteCacheEnable;
+
+    HZD_RouteCacheEnable = 0;
+    ai_bench_route_pass("off", map->hzd);
+
+    HZD_RouteCacheEnable = 1;
+    HZD_ResetRouteCache();
+    ai_bench_route_pass("cold", map->hzd);
+    ai_bench_route_pass("warm", map->hzd);
+
+    HZD_RouteCacheEnable = old_enable;
+}
+
+void AI_BenchThink(void *work, int think1, int think2, void (*think)(void *))
+{
+    int state;
+
+    if (ai_bench_route)
+    {
+        ai_bench_route_run();
+    }
+
+    if (!ai_bench_enable)
+    {
+        think(work);
+        return;
+    }
+
+    if (ai_bench_time != GV_Time)
+    {
+        if (ai_bench_frames >= AI_BENCH_FRAMES)
+        {
+            ai_bench_report();
+        }
+
+        ai_bench_time = GV_Time;
+        ai_bench_frames++;
+    }
+
+    state = ((think1 << 4) | (think2 & 15)) % AI_BENCH_STATES;
+    ai_bench_run(work, state, think);
+}
+
+#endif // DEV_EXE
@@ -0,0 +1,405 @@
+/*
+ * Demo seeking (dev only).
+ *
+ * A demo played from a file (demodebug, DM_ThreadFile) is all in memory, so
+ * DM_SeekStart indexes its records by frame when it starts. Playback then
+ * finds each frame's record in the index instead of walking the stream, and
+ * can move backwards:
+ *
+ *   demo_seek_frame = N    jump to frame N
+ *   demo_seek_pause = 1    hold the current frame; on pad 2, left/right step
+ *                          one frame and L1/R1 step DM_SEEK_KEY frames
+ *
+ * Every record holds the camera and every model's position for its frame,
+ * but the m1e1 tracks and the hind rotors carry state from one frame to the
+ * next. That state is snapshotted in a keyframe the first time playback
+ * reaches each DM_SEEK_KEY frames. A jump restores the nearest keyframe
+ * before the target, removes the charas and replays the records from there
+ * so the target frame starts as it would have. Replays longer than
+ * DM_SEEK_REPLAY_MAX frames (a jump far past the keyframes captured so far)
+ * print a warning.
+ * Effects spawned by the replayed frames are not undone.
+ *
+ * demo_bench = 1 runs every record of the demo back to back when it starts,
+ * without drawing, and prints the hsyncs FrameRunDemo took per frame;
+ * demo_bench = 2 prints every frame as well. This also fills in every
+ * keyframe, and the demo then plays from the start.
+ *
+ * Streamed demos are read once from the CD and can't be seeked.
+ */
+#ifdef DEV_EXE
+
+#include <stdio.h>
+#include <libapi.h>
+#include "common.h"
+#include "libgv/libgv.h"
+#include "kojo/demo.h"
+
+extern int  FrameRunDemo(DemoWork *work, DMO_DAT *data);
+extern void RemoveChain(ACTNODE *root, ACTNODE *node);
+
+#define DM_SEEK_KEY         30
+#define DM_SEEK_REPLAY_MAX  300
+#define DM_SEEK_STATE_SIZE  32
+#define DM_SEEK_FRAME_HSYNC 525     /* two vblanks (NTSC) */
+
+/* followed by DM_SEEK_STATE_SIZE bytes of state per model */
+typedef struct DM_KEYFRAME
+{
+    int frame;      /* 0 until captured */
+} DM_KEYFRAME;
+
+#define DM_KEY_STATE(key, i) ((char *)((key) + 1) + (i) * DM_SEEK_STATE_SIZE)
+
+int demo_seek_frame = -1;
+int demo_seek_pause;
+int demo_bench;
+
+STATIC DMO_DAT **dm_seek_index;
+STATIC char     *dm_seek_keys;
+STATIC int       dm_seek_key_size;
+STATIC int       dm_seek_last;
+
+/* Returns the part of a model's extra data that changes from frame to frame */
+static void *dm_seek_extra(DemoWork *work, int i, int *size)
+{
+    DMO_MDL    *model_file;
+    DEMO_MODEL *model;
+
+    model_file = &work->header->models[i];
+    model = &work->models[i];
+
+    if (!model->extra)
+    {
+        return NULL;
+    }
+
+    if (model_file->filename == GV_StrCode("m1e1") || model_file->filename == GV_StrCode("m1e1demo"))
+    {
+        *size = sizeof(DEMO_M1E1) - offsetof(DEMO_M1E1, field_558_idx);
+        return model->extra->field_558_idx;
+    }
+
+    if (model_file->filename == GV_StrCode("hind") || model_file->filename == GV_StrCode("hinddemo"))
+    {
+        *size = sizeof(DEMO_HIND);
+        return model->extra;
+    }
+
+    return NULL;
+}
+
+static DM_KEYFRAME *dm_seek_key(int slot)
+{
+    return (DM_KEYFRAME *)(dm_seek_keys + slot * dm_seek_key_size);
+}
+
+static void dm_seek_capture(DemoWork *work, int frame)
+{
+    DM_KEYFRAME *key;
+    void        *extra;
+    int          size;
+    int          i;
+
+    key = dm_seek_key(frame / DM_SEEK_KEY);
+    if (key->frame != 0)
+    {
+        return;
+    }
+
+    for (i = 0; i < work->header->n_models; i++)
+    {
+        extra = dm_seek_extra(work, i, &size);
+        if (extra)
+        {
+            GV_CopyMemory(extra, DM_KEY_STATE(key, i), size);
+        }
+    }
+
+    key->frame = frame;
+}
+
+static void dm_seek_restore(DemoWork *work, DM_KEYFRAME *key)
+{
+    void *extra;
+    int   size;
+    int   i;
+
+    for (i = 0; i < work->header->n_models; i++)
+    {
+        extra = dm_seek_extra(work, i, &size);
+        if (extra)
+        {
+            GV_CopyMemory(DM_KEY_STATE(key, i), extra, size);
+        }
+    }
+}
+
+/* Removes every chara, as DestroyDemo does */
+static void dm_seek_clear_charas(DemoWork *work)
+{
+    ACTNODE *node;
+
+    for (node = work->chain.next; node != &work->chain; node = work->chain.next)
+    {
+        if (node->actor1)
+        {
+            GV_DestroyOtherActor(node->actor1);
+        }
+
+        if (node->actor2)
+        {
+            GV_DestroyOtherActor(node->actor2);
+        }
+
+        RemoveChain(&work->chain, node);
+        GV_Free(node);
+    }
+}
+
+/* Brings the demo to the state it had just before 'target' ran */
+static void dm_seek_replay(DemoWork *work, int target)
+{
+    DM_KEYFRAME *key;
+    int          slot;
+    int          from, f;
+
+    // slot 0 is captured when the demo starts
+    for (slot = target / DM_SEEK_KEY; slot > 0; slot--)
+    {
+        key = dm_seek_key(slot);
+        if (key->frame != 0 && key->frame <= target)
+        {
+            break;
+        }
+    }
+
+    key = dm_seek_key(slot);
+
+    dm_seek_clear_charas(work);
+    dm_seek_restore(work, key);
+
+    // the restored state belongs to the keyframe, so the replay starts there
+    from = key->frame;
+    if (target - from > DM_SEEK_REPLAY_MAX)
+    {
+        printf("demo_seek: %d frames to replay from key %d, this takes a while\n",
+               target - from, from);
+    }
+
+    for (f = from; f < target; f++)
+    {
+        dm_seek_capture(work, f);
+        if (!FrameRunDemo(work, dm_seek_index[f]))
+        {
+            break;
+        }
+    }
+
+    printf("demo_seek: %d -> %d, key %d, %d frames replayed\n", dm_seek_last, target,
+           key->frame, f - from);
+}
+
+static void dm_seek_bench(DemoWork *work)
+{
+    long intime, outtime;
+    int  hsyncs, total, max, max_frame, over;
+    int  n_frames;
+    int  f;
+
+    n_frames = work->header->n_frames;
+    total = 0;
+    max = 0;
+    max_frame = 0;
+    over = 0;
+
+    for (f = 1; f <= n_frames; f++)
+    {
+        dm_seek_capture(work, f);
+
+        intime = GetRCnt(RCntCNT1);
+        if (!FrameRunDemo(work, dm_seek_index[f]))
+        {
+            printf("demo_bench: frame %d failed\n", f);
+            break;
+        }
+        outtime = GetRCnt(RCntCNT1);
+
+        hsyncs = (outtime - intime) & 0xffff;
+        total += hsyncs;
+
+        if (hsyncs > max)
+        {
+            max = hsyncs;
+            max_frame = f;
+        }
+
+        if (hsyncs > DM_SEEK_FRAME_HSYNC)
+        {
+            over++;
+        }
+
+        if (demo_bench == 2)
+        {
+            printf("demo_bench: frame %d %d hsync\n", f, hsyncs);
+        }
+    }
+
+    f--;
+    if (f > 0)
+    {
+        printf("demo_bench: %d frames, avg %d.%02d max %d (frame %d) hsync, %d over a frame\n",
+               f, total / f, ((total % f) * 100) / f, max, max_frame, over);
+    }
+
+    demo_bench = 0;
+
+    dm_seek_clear_charas(work);
+    dm_seek_restore(work, dm_seek_key(0));
+}
+
+/*---------------------------------------------------------------------------*/
+
+/* Called once CreateDemo has set up a file demo. */
+void DM_SeekStart(DemoWork *work)
+{
+    DMO_DAT *rec;
+    int      n_frames;
+    int      f;
+
+    DM_SeekEnd();
+
+    n_frames = work->header->n_frames;
+    dm_seek_key_size = sizeof(DM_KEYFRAME) + work->header->n_models * DM_SEEK_STATE_SIZE;
+
+    dm_seek_index = GV_Malloc((n_frames + 1) * sizeof(DMO_DAT *));
+    dm_seek_keys = GV_Malloc((n_frames / DM_SEEK_KEY + 1) * dm_seek_key_size);
+    if (!dm_seek_index || !dm_seek_keys)
+    {
+        printf("demo_seek: no memory\n");
+        DM_SeekEnd();
+        return;
+    }
+
+    GV_ZeroMemory(dm_seek_keys, (n_frames / DM_SEEK_KEY + 1) * dm_seek_key_size);
+
+    // the header comes first and shares the tag and frame of the records
+    rec = (DMO_DAT *)work->stream;
+    for (f = 0; f <= n_frames; f++)
+    {
+        while (rec->frame < f && rec->tag != 0)
+        {
+            rec = (DMO_DAT *)((char *)rec + rec->tag);
+        }
+
+        if (rec->frame != f)
+        {
+            printf("demo_seek: no record for frame %d\n", f);
+            DM_SeekEnd();
+            return;
+        }
+
+        dm_seek_index[f] = rec;
+    }
+
+    dm_seek_last = 0;
+    dm_seek_capture(work, 1);
+
+    printf("demo_seek: %d frames indexed\n", n_frames);
+
+    if (demo_bench)
+    {
+        dm_seek_bench(work);
+    }
+}
+
+/* Called once FileAct has picked work->frame, before it looks for the record. */
+void DM_SeekUpdate(DemoWork *work, int time)
+{
+    int n_frames;
+    int target;
+    int press;
+
+    if (!dm_seek_index)
+    {
+        return;
+    }
+
+    n_frames = work->header->n_frames;
+
+    if (demo_seek_frame >= 0 || demo_seek_pause)
+    {
+        if (demo_seek_frame >= 0)
+        {
+            target = demo_seek_frame;
+            demo_seek_frame = -1;
+        }
+        else
+        {
+            target = dm_seek_last;
+            press = GV_PadData[1].press;
+
+            if (press & PAD_LEFT)
+            {
+                target--;
+            }
+            if (press & PAD_RIGHT)
+            {
+                target++;
+            }
+            if (press & PAD_L1)
+            {
+                target -= DM_SEEK_KEY;
+            }
+            if (press & PAD_R1)
+            {
+                target += DM_SEEK_KEY;
+            }
+        }
+
+        if (target < 1)
+        {
+            target = 1;
+        }
+        if (target > n_frames)
+        {
+            target = n_frames;
+        }
+
+        if (target < dm_seek_last || target > dm_seek_last + 1)
+        {
+            dm_seek_replay(work, target);
+        }
+
+        // playback carries on from the target
+        work->frame = target;
+        work->start_time = time - target * 2;
+    }
+
+    if (work->frame > n_frames)
+    {
+        return;
+    }
+
+    dm_seek_capture(work, work->frame);
+    work->stream = (DMO_DEF *)dm_seek_index[work->frame];
+    dm_seek_last = work->frame;
+}
+
+/* Called when a file demo ends. */
+void DM_SeekEnd(void)
+{
+    if (dm_seek_index)
+    {
+        GV_Free(dm_seek_index);
+        dm_seek_index = NULL;
+    }
+
+    if (dm_seek_keys)
+    {
+        GV_Free(dm_seek_keys);
+        dm_seek_keys = NULL;
+    }
+}
+
+#endif // DEV_EXE
@@ -0,0 +1,191 @@
+/*
+ * Font benchmark (dev only).
+ *
+ * Set font_bench_request and open the codec: once the radio data is loaded,
+ * every talk line of the frequency's script is rendered into a subtitle
+ * sized KCB, three times over:
+ *
+ *   bits   font_draw_string with font_glyph_cache off (the original loops)
+ *   rows   font_draw_string with the glyph row tables
+ *   print  font_print_string of the same line again, from font_print_cache
+ *
+ * The buffer of every line is checksummed in the first two passes and any
+ * line that differs is reported. The talk lines are found by scanning the
+ * script for RDCODE_TALK entries, so lines inside if/switch blocks count too.
+ */
+#ifdef DEV_EXE
+
+#include <stdio.h>
+#include <libapi.h>
+#include "common.h"
+#include "libgv/libgv.h"
+#include "libgcl/libgcl.h"
+#include "font/font.h"
+
+#define FONT_BENCH_LINES    256
+
+int font_bench_request;
+
+STATIC RECT          font_bench_rect = {960, 256, 64, 38};
+STATIC const char   *font_bench_line[FONT_BENCH_LINES];
+STATIC unsigned long font_bench_sum[FONT_BENCH_LINES];
+
+static unsigned long font_bench_checksum(KCB *kcb)
+{
+    unsigned long  sum;
+    unsigned long *ptr;
+    int            i;
+
+    ptr = kcb->font_buffer;
+    sum = 0;
+
+    for (i = (kcb->width_info * kcb->height_info) / 4; i > 0; i--)
+    {
+        sum = sum * 31 + *ptr++;
+    }
+
+    return sum;
+}
+
+/* Returns the hsyncs taken to draw every line, and checks or records their sums */
+static int font_bench_draw(KCB *kcb, int count, int check)
+{
+    long          intime, outtime;
+    int           hsyncs;
+    int           bad;
+    unsigned long sum;
+    int           i;
+
+    hsyncs = 0;
+    bad = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        font_clear(kcb);
+
+        intime = GetRCnt(RCntCNT1);
+        font_draw_string(kcb, 0, kcb->ytop, font_bench_line[i], kcb->color);
+        outtime = GetRCnt(RCntCNT1);
+        hsyncs += (outtime - intime) & 0xffff;
+
+        sum = font_bench_checksum(kcb);
+        if (!check)
+        {
+            font_bench_sum[i] = sum;
+        }
+        else if (sum != font_bench_sum[i] && bad++ == 0)
+        {
+            printf("font_bench: line %d differs\n", i);
+        }
+    }
+
+    return hsyncs;
+}
+
+static int font_bench_print(KCB *kcb, int count)
+{
+    long intime, outtime;
+    int  hsyncs;
+    int  i;
+
+    hsyncs = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        font_print_string(kcb, font_bench_line[i]);
+
+        intime = GetRCnt(RCntCNT1);
+        font_print_string(kcb, font_bench_line[i]);
+        outtime = GetRCnt(RCntCNT1);
+        hsyncs += (outtime - intime) & 0xffff;
+    }
+
+    return hsyncs;
+}
+
+/* Collects the talk lines of a radio script block, see menu_gcl_exec_block_800478B4 */
+static int font_bench_find_lines(unsigned char *block)
+{
+    unsigned char *ptr, *end, *text;
+    int            size;
+    int            count;
+
+    ptr = block + 3;
+    end = ptr + ((block[1] << 8) | block[2]);
+    count = 0;
+
+    for (; ptr + 10 < end && count < FONT_BENCH_LINES; ptr++)
+    {
+        if (ptr[0] != RDCODE_ENDLINE || ptr[1] != RDCODE_TALK)
+        {
+            continue;
+        }
+
+        // the size counts itself, then three words come before the text
+        size = (ptr[2] << 8) | ptr[3];
+        text = ptr + 10;
+        if (size < 9 || ptr + 2 + size > end || ptr[2 + size - 1] != '\0')
+        {
+            continue;
+        }
+
+        font_bench_line[count++] = (const char *)text;
+        ptr += 1 + size;
+    }
+
+    return count;
+}
+
+void font_bench_radio(unsigned char *block)
+{
+    KCB   kcb;
+    void *buffer;
+    int   count;
+    int   bits, rows, print;
+    int   old_glyph, old_print;
+
+    font_bench_request = 0;
+
+    count = font_bench_find_lines(block);
+    if (count == 0)
+    {
+        printf("font_bench: no talk lines\n");
+        return;
+    }
+
+    // same layout as the subtitles, see menu_jimaku_init_helper
+    font_init_kcb(&kcb, &font_bench_rect, 960, 510);
+    font_set_kcb(&kcb, -1, -1, 0, 6, 2, 0);
+
+    buffer = GV_Malloc(font_get_buffer_size(&kcb));
+    if (!buffer)
+    {
+        printf("font_bench: no memory\n");
+        return;
+    }
+
+    font_set_buffer(&kcb, buffer);
+
+    old_glyph = font_glyph_cache;
+    old_print = font_print_cache;
+
+    font_glyph_cache = 0;
+    bits = font_bench_draw(&kcb, count, 0);
+
+    font_glyph_cache = 1;
+    rows = font_bench_draw(&kcb, count, 1);
+
+    font_print_cache = 1;
+    print = font_bench_print(&kcb, count);
+
+    font_glyph_cache = old_glyph;
+    font_print_cache = old_print;
+
+    printf("font_bench %d lines: bits %d rows %d print %d hsync\n", count, bits, rows, print);
+
+    // nothing else may find this buffer in the print cache once it is freed
+    font_set_buffer(&kcb, NULL);
+    GV_Free(buffer);
+}
+
+#endif // DEV_EXE
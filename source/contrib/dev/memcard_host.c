@@ -0,0 +1,661 @@
+/*
+ * Host memory card images (dev only).
+ *
+ * Set memcard_host before memcard_init runs and the memcard_* functions use
+ * two standard 128 KB .mcr images on the host (PCdrv) instead of the cards:
+ * memcard_host_file[0] for port 1 and memcard_host_file[1] for port 2. A
+ * missing image is an empty slot and an image without the "MC" header is an
+ * unformatted card (an empty file will do), which memcard_format turns into
+ * a blank card.
+ *
+ * The directory block of an image is read once and kept in memory, so
+ * memcard_check and memcard_get_files don't read from the host. Reads and
+ * writes count down memcard_get_status at memcard_host_rate bytes per vblank
+ * (128 is about the speed of a card, 0 finishes at once), so the save and
+ * load menus poll it as they do on hardware. Written data and changed
+ * directory frames are queued and go to the host in one batch, with a single
+ * open and close of the image, when the write completes. A delete only
+ * changes the directory, which goes out with the next batch or check.
+ *
+ * memcard_host_fail = N makes the next N accesses time out, as a card that
+ * was pulled out does: memcard_check reports no card, and reads and writes
+ * end with -1 and write nothing.
+ */
+#ifdef DEV_EXE
+
+#include <stdio.h>
+#include <string.h>
+#include <libetc.h>
+#include "common.h"
+#include "memcard/memcard.h"
+
+// unlike the other dev modules, images are opened for read/write
+extern int PCopen(char *name, int flags, int perms);
+extern int PCcreat(char *name, int perms);
+extern int PClseek(int fd, int offset, int mode);
+extern int PCread(int fd, char *buff, int len);
+extern int PCwrite(int fd, char *buff, int len);
+extern int PCclose(int fd);
+
+extern MEM_CARD gMemCards[2];
+
+#define MCR_FRAME_SIZE      128
+#define MCR_FRAMES          (MC_BLOCK_SIZE / MCR_FRAME_SIZE)
+#define MCR_BLOCKS          15
+#define MCR_SIZE            ((MCR_BLOCKS + 1) * MC_BLOCK_SIZE)
+
+#define MCR_FIRST           0x51
+#define MCR_MIDDLE          0x52
+#define MCR_LAST            0x53
+#define MCR_FREE            0xA0
+#define MCR_NO_NEXT         0xFFFF
+
+#define MCH_QUEUE_MAX       16
+
+#define ROUND_UP(val,rounding) (((val) + (rounding) - 1) / (rounding) * (rounding))
+
+/* Frame 0 of the directory block is the card header, frames 1..15 describe
+ * blocks 1..15. The frame of the first block of a file holds its name and
+ * size, and the frames are chained through 'next' */
+typedef struct MCR_FRAME
+{
+    unsigned long  state;
+    unsigned long  size;
+    unsigned short next;
+    char           name[21];
+    char           pad[96];
+    unsigned char  xor;
+} MCR_FRAME;
+
+typedef struct MCH_WRITE
+{
+    int   offset;
+    char *buffer;
+    int   size;
+} MCH_WRITE;
+
+enum {
+    MCH_UNKNOWN,
+    MCH_NONE,
+    MCH_UNFORMATTED,
+    MCH_READY
+};
+
+int  memcard_host;
+int  memcard_host_rate = MCR_FRAME_SIZE;
+int  memcard_host_fail;
+char memcard_host_file[2][16] = {"MEMCARD1.MCR", "MEMCARD2.MCR"};
+
+STATIC MCR_FRAME mch_dir[2][MCR_FRAMES];
+STATIC MCR_FRAME mch_zero;
+STATIC int       mch_state[2];
+STATIC int       mch_dirty[2];
+
+STATIC MCH_WRITE mch_queue[MCH_QUEUE_MAX];
+STATIC int       mch_queued;
+
+STATIC int mch_io_port;
+STATIC int mch_io_size;
+STATIC int mch_io_vblank;
+STATIC int mch_io_fail;
+
+/* the frames mch_create took for the pending write, as they were before */
+STATIC MCR_FRAME mch_undo[MCR_FRAMES];
+STATIC int       mch_undo_mask;
+STATIC int       mch_undo_dirty;
+
+static void mch_set_xor(MCR_FRAME *frame)
+{
+    unsigned char *ptr;
+    unsigned char  xor;
+    int            i;
+
+    ptr = (unsigned char *)frame;
+    xor = 0;
+
+    for (i = MCR_FRAME_SIZE - 1; i > 0; i--)
+    {
+        xor ^= *ptr++;
+    }
+
+    frame->xor = xor;
+}
+
+static void mch_set_dirty(int port, int frame)
+{
+    mch_set_xor(&mch_dir[port][frame]);
+    mch_dirty[port] |= 1 << frame;
+}
+
+static void mch_load(int port)
+{
+    MCR_FRAME *dir;
+    int        fd;
+    int        len;
+
+    dir = mch_dir[port];
+    mch_dirty[port] = 0;
+
+    fd = PCopen(memcard_host_file[port], 0, 0);
+    if (fd < 0)
+    {
+        mch_state[port] = MCH_NONE;
+        return;
+    }
+
+    len = PCread(fd, (char *)dir, MC_BLOCK_SIZE);
+    PCclose(fd);
+
+    if (len != MC_BLOCK_SIZE || dir->state != ('M' | ('C' << 8)))
+    {
+        mch_state[port] = MCH_UNFORMATTED;
+        return;
+    }
+
+    mch_state[port] = MCH_READY;
+    printf("MEMCARD HOST %s\n", memcard_host_file[port]);
+}
+
+/* Writes the changed directory frames, and the queued data if it is for this
+ * port, returns 0 on error */
+static int mch_flush(int port)
+{
+    MCH_WRITE *run;
+    int        queued;
+    int        fd;
+    int        lo, hi;
+    int        i;
+
+    queued = (port == mch_io_port) ? mch_queued : 0;
+
+    if (queued == 0 && mch_dirty[port] == 0)
+    {
+        return 1;
+    }
+
+    fd = PCopen(memcard_host_file[port], 2, 0);
+    if (fd < 0)
+    {
+        printf("ERROR : MEMCARD HOST can't open %s\n", memcard_host_file[port]);
+        if (queued)
+        {
+            mch_queued = 0;
+        }
+        return 0;
+    }
+
+    if (mch_dirty[port])
+    {
+        for (lo = 0; !(mch_dirty[port] & (1 << lo)); lo++);
+        for (hi = MCR_BLOCKS; !(mch_dirty[port] & (1 << hi)); hi--);
+
+        PClseek(fd, lo * MCR_FRAME_SIZE, 0);
+        PCwrite(fd, (char *)&mch_dir[port][lo], (hi - lo + 1) * MCR_FRAME_SIZE);
+        mch_dirty[port] = 0;
+    }
+
+    run = mch_queue;
+    for (i = queued; i > 0; i--, run++)
+    {
+        PClseek(fd, run->offset, 0);
+        PCwrite(fd, run->buffer, run->size);
+    }
+
+    if (queued)
+    {
+        mch_queued = 0;
+    }
+
+    PCclose(fd);
+    return 1;
+}
+
+static int mch_find(int port, const char *filename)
+{
+    MCR_FRAME *frame;
+    int        i;
+
+    frame = &mch_dir[port][1];
+    for (i = 1; i <= MCR_BLOCKS; i++, frame++)
+    {
+        if (frame->state == MCR_FIRST && strcmp(frame->name, filename) == 0)
+        {
+            return i;
+        }
+    }
+
+    return 0;
+}
+
+/* Fills blocks[] with the file's chain, returns its length */
+static int mch_chain(int port, int first, int *blocks)
+{
+    int count;
+    int block;
+
+    count = 0;
+    for (block = first; block >= 1 && block <= MCR_BLOCKS && count < MCR_BLOCKS; count++)
+    {
+        blocks[count] = block;
+        block = mch_dir[port][block].next + 1;
+    }
+
+    return count;
+}
+
+/* Creates a file of 'count' blocks, as open with O_CREAT does */
+static int mch_create(int port, const char *filename, int count, int *blocks)
+{
+    MCR_FRAME *frame;
+    int        found;
+    int        i;
+
+    found = 0;
+    for (i = 1; i <= MCR_BLOCKS && found < count; i++)
+    {
+        if ((mch_dir[port][i].state & 0xF0) == MCR_FREE)
+        {
+            blocks[found++] = i;
+        }
+    }
+
+    if (found < count)
+    {
+        return 0;
+    }
+
+    mch_undo_dirty = mch_dirty[port];
+
+    for (i = 0; i < count; i++)
+    {
+        frame = &mch_dir[port][blocks[i]];
+        mch_undo[blocks[i]] = *frame;
+        mch_undo_mask |= 1 << blocks[i];
+
+        memset(frame, 0, sizeof(MCR_FRAME));
+
+        frame->state = (i == 0) ? MCR_FIRST : (i == count - 1) ? MCR_LAST : MCR_MIDDLE;
+        frame->next = (i < count - 1) ? blocks[i + 1] - 1 : MCR_NO_NEXT;
+
+        if (i == 0)
+        {
+            frame->size = count * MC_BLOCK_SIZE;
+            strncpy(frame->name, filename, sizeof(frame->name) - 1);
+        }
+
+        mch_set_dirty(port, blocks[i]);
+    }
+
+    return count;
+}
+
+/* Puts back the frames mch_create took, for a write that didn't happen */
+static void mch_undo_create(int port)
+{
+    int i;
+
+    for (i = 1; i <= MCR_BLOCKS; i++)
+    {
+        if (mch_undo_mask & (1 << i))
+        {
+            mch_dir[port][i] = mch_undo[i];
+            mch_dirty[port] = (mch_dirty[port] & ~(1 << i)) | (mch_undo_dirty & (1 << i));
+        }
+    }
+
+    mch_undo_mask = 0;
+}
+
+static void mch_start_io(int port, int size, int fail)
+{
+    mch_io_port = port;
+    mch_io_size = size;
+    mch_io_vblank = VSync(-1);
+    mch_io_fail = fail;
+}
+
+static int mch_take_fail(void)
+{
+    if (memcard_host_fail > 0)
+    {
+        memcard_host_fail--;
+        return 1;
+    }
+
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+
+void memcard_host_init(void)
+{
+    mch_state[0] = MCH_UNKNOWN;
+    mch_state[1] = MCH_UNKNOWN;
+    mch_queued = 0;
+    mch_io_size = 0;
+    memcard_reset_status();
+}
+
+void memcard_host_exit(void)
+{
+    mch_flush(0);
+    mch_flush(1);
+}
+
+int memcard_host_check(int port)
+{
+    MEM_CARD *card;
+
+    card = &gMemCards[port];
+
+    if (mch_take_fail())
+    {
+        printf("[C.S.T.O]");
+        mch_state[port] = MCH_UNKNOWN;
+        card->last_op = 3;
+        return 0xc0000003;
+    }
+
+    if (mch_state[port] != MCH_READY)
+    {
+        mch_load(port);
+    }
+    else if (mch_io_size <= 0)
+    {
+        mch_flush(port);
+    }
+
+    switch (mch_state[port])
+    {
+    case MCH_NONE:
+        card->last_op = 3;
+        return 0xc0000003;
+
+    case MCH_UNFORMATTED:
+        card->last_op = 5;
+        return 0x80000001;
+    }
+
+    if (card->last_op == 1)
+    {
+        return 0;
+    }
+
+    // as memcard_check does for a card it hasn't seen yet
+    card->last_op = 4;
+    return 0x1000000;
+}
+
+MEM_CARD *memcard_host_get_files(int port)
+{
+    MEM_CARD      *card;
+    MEM_CARD_FILE *file;
+    MCR_FRAME     *frame;
+    int            used;
+    int            i;
+
+    card = &gMemCards[port];
+    if (card->last_op != 1 && card->last_op != 4)
+    {
+        return 0;
+    }
+
+    card->card_idx = port;
+    card->last_op = 1;
+    card->file_count = 0;
+    used = 0;
+
+    file = card->files;
+    frame = &mch_dir[port][1];
+    for (i = 1; i <= MCR_BLOCKS; i++, frame++)
+    {
+        if ((frame->state & 0xF0) != (MCR_FIRST & 0xF0))
+        {
+            continue;
+        }
+
+        used++;
+
+        if (frame->state == MCR_FIRST)
+        {
+            memcpy(file->name, frame->name, sizeof(file->name));
+            file->field_14 = 0;
+            file->field_18_size = frame->size;
+            file++;
+            card->file_count++;
+        }
+    }
+
+    card->free_blocks = MCR_BLOCKS - used;
+    return card;
+}
+
+int memcard_host_delete(int port, const char *filename)
+{
+    int blocks[MCR_BLOCKS];
+    int count;
+    int i;
+
+    if (gMemCards[port].last_op != 1)
+    {
+        return 0;
+    }
+
+    count = mch_chain(port, mch_find(port, filename), blocks);
+    if (count == 0)
+    {
+        printf("ERROR : can't delete %s\n", filename);
+        return 0;
+    }
+
+    // deleted frames keep their position in the chain, as on a card
+    for (i = 0; i < count; i++)
+    {
+        mch_dir[port][blocks[i]].state = MCR_FREE | (mch_dir[port][blocks[i]].state & 0x0F);
+        mch_set_dirty(port, blocks[i]);
+    }
+
+    printf("Deleted File %s", filename);
+    return 1;
+}
+
+void memcard_host_write(int port, const char *filename, int offset, char *buffer, int size)
+{
+    MCH_WRITE *run;
+    int        blocks[MCR_BLOCKS];
+    int        count;
+    int        pos, end, len;
+    int        image;
+
+    mch_undo_mask = 0;
+
+    count = mch_chain(port, mch_find(port, filename), blocks);
+    if (count == 0)
+    {
+        count = mch_create(port, filename, ROUND_UP(size, MC_BLOCK_SIZE) / MC_BLOCK_SIZE, blocks);
+    }
+
+    size = ROUND_UP(size, MCR_FRAME_SIZE);
+    end = offset + size;
+
+    if (mch_state[port] != MCH_READY || count == 0 || end > count * MC_BLOCK_SIZE)
+    {
+        printf("MEMCARD WRITE ERROR %s\n", filename);
+        mch_undo_create(port);
+        mch_io_size = -1;
+        return;
+    }
+
+    // split the write at block boundaries, joining blocks that follow on in the image
+    mch_queued = 0;
+    run = mch_queue - 1;
+
+    for (pos = offset; pos < end; pos += len)
+    {
+        len = MC_BLOCK_SIZE - (pos % MC_BLOCK_SIZE);
+        if (len > end - pos)
+        {
+            len = end - pos;
+        }
+
+        image = blocks[pos / MC_BLOCK_SIZE] * MC_BLOCK_SIZE + (pos % MC_BLOCK_SIZE);
+
+        if (mch_queued > 0 && run->offset + run->size == image)
+        {
+            run->size += len;
+            continue;
+        }
+
+        run++;
+        run->offset = image;
+        run->buffer = buffer + (pos - offset);
+        run->size = len;
+        mch_queued++;
+    }
+
+    printf("MEMCARD WRITE %s SIZE %d (%d runs)\n", filename, size, mch_queued);
+    mch_start_io(port, size, mch_take_fail());
+}
+
+void memcard_host_read(int port, const char *filename, int offset, char *buffer, int size)
+{
+    int blocks[MCR_BLOCKS];
+    int count;
+    int pos, end, len;
+    int fd;
+
+    count = mch_chain(port, mch_find(port, filename), blocks);
+
+    size = ROUND_UP(size, MCR_FRAME_SIZE);
+    end = offset + size;
+
+    if (mch_state[port] != MCH_READY || count == 0 || end > count * MC_BLOCK_SIZE)
+    {
+        printf("MEMCARD READ ERROR %s\n", filename);
+        mch_io_size = -1;
+        return;
+    }
+
+    if (mch_take_fail())
+    {
+        mch_start_io(port, size, 1);
+        return;
+    }
+
+    fd = PCopen(memcard_host_file[port], 0, 0);
+    if (fd < 0)
+    {
+        printf("MEMCARD READ ERROR %s\n", filename);
+        mch_io_size = -1;
+        return;
+    }
+
+    for (pos = offset; pos < end; pos += len)
+    {
+        len = MC_BLOCK_SIZE - (pos % MC_BLOCK_SIZE);
+        if (len > end - pos)
+        {
+            len = end - pos;
+        }
+
+        PClseek(fd, blocks[pos / MC_BLOCK_SIZE] * MC_BLOCK_SIZE + (pos % MC_BLOCK_SIZE), 0);
+        PCread(fd, buffer + (pos - offset), len);
+    }
+
+    PCclose(fd);
+
+    printf("MEMCARD READ %s SIZE %d\n", filename, size);
+    mch_start_io(port, size, 0);
+}
+
+int memcard_host_get_status(void)
+{
+    int left;
+
+    if (mch_io_size <= 0)
+    {
+        return mch_io_size;
+    }
+
+    if (memcard_host_rate > 0)
+    {
+        left = mch_io_size - (VSync(-1) - mch_io_vblank) * memcard_host_rate;
+        if (left > 0)
+        {
+            return left;
+        }
+    }
+
+    if (mch_io_fail)
+    {
+        printf("[C.H.T.O]");
+        mch_undo_create(mch_io_port);
+        mch_queued = 0;
+        mch_io_size = -1;
+    }
+    else
+    {
+        mch_io_size = mch_flush(mch_io_port) ? 0 : -1;
+        mch_undo_mask = 0;
+    }
+
+    return mch_io_size;
+}
+
+int memcard_host_format(int port)
+{
+    MCR_FRAME *dir;
+    int        fd;
+    int        i;
+
+    if (gMemCards[port].last_op != 5)
+    {
+        printf("ERROR : MEMCARD FORMATED CARD\n");
+        return 0;
+    }
+
+    dir = mch_dir[port];
+    memset(dir, 0, MC_BLOCK_SIZE);
+
+    dir[0].state = 'M' | ('C' << 8);
+    mch_set_xor(&dir[0]);
+
+    for (i = 1; i <= MCR_BLOCKS; i++)
+    {
+        dir[i].state = MCR_FREE;
+        dir[i].next = MCR_NO_NEXT;
+        mch_set_xor(&dir[i]);
+    }
+
+    // the broken sector list, and the write test frame is a copy of the header
+    for (i = MCR_BLOCKS + 1; i < MCR_BLOCKS + 21; i++)
+    {
+        dir[i].state = 0xFFFFFFFF;
+        dir[i].next = MCR_NO_NEXT;
+        mch_set_xor(&dir[i]);
+    }
+
+    dir[MCR_FRAMES - 1] = dir[0];
+
+    fd = PCcreat(memcard_host_file[port], 0);
+    if (fd < 0)
+    {
+        printf("ERROR : MEMCARD FORMAT\n");
+        mch_state[port] = MCH_UNKNOWN;
+        return 0;
+    }
+
+    // the blocks read back as zeroes once the last frame is written
+    PCwrite(fd, (char *)dir, MC_BLOCK_SIZE);
+    PClseek(fd, MCR_SIZE - MCR_FRAME_SIZE, 0);
+    PCwrite(fd, (char *)&mch_zero, MCR_FRAME_SIZE);
+    PCclose(fd);
+
+    printf("FORMATED %d\n", port);
+    mch_state[port] = MCH_READY;
+    mch_dirty[port] = 0;
+    gMemCards[port].last_op = 1;
+    return 1;
+}
+
+#endif // DEV_EXE
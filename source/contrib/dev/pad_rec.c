@@ -0,0 +1,431 @@
+/*
+ * Pad recorder (dev only).
+ *
+ * Set pad_rec_request to PAD_REC_RECORD or PAD_REC_REPLAY (from the debugger
+ * or from code) and the session starts with the next stage's scenario. While
+ * recording, the final GV_PadData of every in-stage frame is written to
+ * pad_rec_file on the host (PCdrv), together with the rand() seed set at the
+ * start of the session. Replay reseeds rand() and feeds the recorded pad data
+ * back instead of the controller, so a recorded session plays the same again
+ * and can be used as a repeatable benchmark. PAD_REC_STOP ends either mode.
+ *
+ * The file is a PAD_REC_HEADER followed by a byte stream:
+ *
+ *   0x00..0x7F     1..128 frames with the same pad data as the last one
+ *   PAD_REC_DELTA  32-bit mask of changed GV_PadData words, then the words
+ *   PAD_REC_SYNC   32-bit checksum of the player state, every 64 frames
+ *   PAD_REC_END    end of the session
+ *
+ * Frames are only counted while a stage is running (GM_LoadComplete > 0),
+ * since the time a load takes varies from one run to the next. Replay prints
+ * the first frame where the sync checksum differs, and the frames and vblanks
+ * the session took when it ends.
+ */
+#ifdef DEV_EXE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <libetc.h>
+#include "common.h"
+#include "libgv/libgv.h"
+#include "game/game.h"
+
+extern int PCopen(const char *name /*, int flags, int perms*/);
+extern int PCcreat(char *name /*, int perms */);
+extern int PCread(int fd, char *buff, int len);
+extern int PCwrite(int fd, char *buff, int len);
+extern int PCclose(int fd);
+
+#define PAD_REC_MAGIC       0x52444150  /* "PADR" */
+#define PAD_REC_VERSION     1
+#define PAD_REC_BUF_SIZE    0x2000
+#define PAD_REC_WORDS       (sizeof(GV_PadData) / sizeof(u_short))
+#define PAD_REC_SYNC_FRAMES 64
+
+#define PAD_REC_RUN_MAX     0x80
+#define PAD_REC_DELTA       0x80
+#define PAD_REC_SYNC        0x81
+#define PAD_REC_END         0xFF
+
+typedef struct PAD_REC_HEADER
+{
+    unsigned long magic;
+    unsigned long version;
+    unsigned long seed;
+    unsigned long words;
+} PAD_REC_HEADER;
+
+enum {
+    PAD_REC_IDLE,
+    PAD_REC_RECORDING,
+    PAD_REC_REPLAYING
+};
+
+int  pad_rec_request;
+char pad_rec_file[16] = "PADREC.DAT";
+
+STATIC int     pad_rec_state;
+STATIC int     pad_rec_fd = -1;
+STATIC int     pad_rec_frames;
+STATIC int     pad_rec_run;
+STATIC int     pad_rec_desync;
+STATIC int     pad_rec_vblank;
+STATIC u_short pad_rec_last[PAD_REC_WORDS];
+
+STATIC unsigned char pad_rec_buf[PAD_REC_BUF_SIZE];
+STATIC int           pad_rec_pos;
+STATIC int           pad_rec_len;
+
+static unsigned long pad_rec_checksum(void)
+{
+    unsigned long sum;
+
+    sum = GM_PlayerPosition.vx;
+    sum = sum * 31 + GM_PlayerPosition.vy;
+    sum = sum * 31 + GM_PlayerPosition.vz;
+    sum = sum * 31 + GM_PlayerStatus;
+    sum = sum * 31 + GM_PlayerMap;
+    return sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void pad_rec_flush(void)
+{
+    if (pad_rec_pos > 0)
+    {
+        PCwrite(pad_rec_fd, (char *)pad_rec_buf, pad_rec_pos);
+        pad_rec_pos = 0;
+    }
+}
+
+static void pad_rec_put(int byte)
+{
+    if (pad_rec_pos >= PAD_REC_BUF_SIZE)
+    {
+        pad_rec_flush();
+    }
+
+    pad_rec_buf[pad_rec_pos++] = byte;
+}
+
+static void pad_rec_put_long(unsigned long value)
+{
+    pad_rec_put(value);
+    pad_rec_put(value >> 8);
+    pad_rec_put(value >> 16);
+    pad_rec_put(value >> 24);
+}
+
+static void pad_rec_put_run(void)
+{
+    if (pad_rec_run > 0)
+    {
+        pad_rec_put(pad_rec_run - 1);
+        pad_rec_run = 0;
+    }
+}
+
+static int pad_rec_get(void)
+{
+    if (pad_rec_pos >= pad_rec_len)
+    {
+        pad_rec_len = PCread(pad_rec_fd, (char *)pad_rec_buf, PAD_REC_BUF_SIZE);
+        pad_rec_pos = 0;
+
+        if (pad_rec_len <= 0)
+        {
+            pad_rec_len = 0;
+            return PAD_REC_END;
+        }
+    }
+
+    return pad_rec_buf[pad_rec_pos++];
+}
+
+static unsigned long pad_rec_get_long(void)
+{
+    unsigned long value;
+
+    value = pad_rec_get();
+    value |= pad_rec_get() << 8;
+    value |= pad_rec_get() << 16;
+    value |= pad_rec_get() << 24;
+    return value;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void pad_rec_stop(void)
+{
+    switch (pad_rec_state)
+    {
+    case PAD_REC_RECORDING:
+        pad_rec_put_run();
+        pad_rec_put(PAD_REC_END);
+        pad_rec_flush();
+        printf("pad_rec: recorded %d frames to %s\n", pad_rec_frames, pad_rec_file);
+        break;
+
+    case PAD_REC_REPLAYING:
+        printf("pad_rec: replayed %d frames in %d vblanks, %s\n", pad_rec_frames,
+               VSync(-1) - pad_rec_vblank, pad_rec_desync ? "desync" : "in sync");
+        break;
+    }
+
+    if (pad_rec_fd >= 0)
+    {
+        PCclose(pad_rec_fd);
+        pad_rec_fd = -1;
+    }
+
+    pad_rec_state = PAD_REC_IDLE;
+}
+
+static void pad_rec_start_record(void)
+{
+    PAD_REC_HEADER header;
+
+    pad_rec_fd = PCcreat(pad_rec_file);
+    if (pad_rec_fd < 0)
+    {
+        printf("pad_rec: can't create %s\n", pad_rec_file);
+        return;
+    }
+
+    header.magic = PAD_REC_MAGIC;
+    header.version = PAD_REC_VERSION;
+    header.seed = VSync(-1);
+    header.words = PAD_REC_WORDS;
+    PCwrite(pad_rec_fd, (char *)&header, sizeof(header));
+
+    srand(header.seed);
+
+    pad_rec_pos = 0;
+    pad_rec_state = PAD_REC_RECORDING;
+    printf("pad_rec: recording to %s, seed %08lX\n", pad_rec_file, header.seed);
+}
+
+static void pad_rec_start_replay(void)
+{
+    PAD_REC_HEADER header;
+
+    pad_rec_fd = PCopen(pad_rec_file);
+    if (pad_rec_fd < 0)
+    {
+        printf("pad_rec: can't open %s\n", pad_rec_file);
+        return;
+    }
+
+    if (PCread(pad_rec_fd, (char *)&header, sizeof(header)) != sizeof(header) ||
+        header.magic != PAD_REC_MAGIC || header.version != PAD_REC_VERSION ||
+        header.words != PAD_REC_WORDS)
+    {
+        printf("pad_rec: %s is not a pad recording\n", pad_rec_file);
+        PCclose(pad_rec_fd);
+        pad_rec_fd = -1;
+        return;
+    }
+
+    srand(header.seed);
+
+    pad_rec_pos = 0;
+    pad_rec_len = 0;
+    pad_rec_desync = 0;
+    pad_rec_vblank = VSync(-1);
+    pad_rec_state = PAD_REC_REPLAYING;
+    printf("pad_rec: replaying %s, seed %08lX\n", pad_rec_file, header.seed);
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void pad_rec_record_frame(void)
+{
+    u_short      *words;
+    unsigned long mask;
+    int           i;
+
+    if (pad_rec_frames > 0 && pad_rec_frames % PAD_REC_SYNC_FRAMES == 0)
+    {
+        pad_rec_put_run();
+        pad_rec_put(PAD_REC_SYNC);
+        pad_rec_put_long(pad_rec_checksum());
+    }
+
+    words = (u_short *)GV_PadData;
+    mask = 0;
+
+    for (i = 0; i < PAD_REC_WORDS; i++)
+    {
+        if (words[i] != pad_rec_last[i])
+        {
+            mask |= 1 << i;
+        }
+    }
+
+    if (mask == 0)
+    {
+        if (++pad_rec_run == PAD_REC_RUN_MAX)
+        {
+            pad_rec_put_run();
+        }
+    }
+    else
+    {
+        pad_rec_put_run();
+        pad_rec_put(PAD_REC_DELTA);
+        pad_rec_put_long(mask);
+
+        for (i = 0; i < PAD_REC_WORDS; i++)
+        {
+            if (mask & (1 << i))
+            {
+                pad_rec_put(words[i]);
+                pad_rec_put(words[i] >> 8);
+                pad_rec_last[i] = words[i];
+            }
+        }
+    }
+
+    pad_rec_frames++;
+}
+
+static void pad_rec_replay_frame(void)
+{
+    unsigned long mask, sum;
+    int           code;
+    int           i;
+
+    if (pad_rec_run > 0)
+    {
+        pad_rec_run--;
+    }
+    else
+    {
+        for (;;)
+        {
+            code = pad_rec_get();
+
+            if (code == PAD_REC_SYNC)
+            {
+                sum = pad_rec_get_long();
+                if (sum != pad_rec_checksum() && !pad_rec_desync)
+                {
+                    printf("pad_rec: desync at frame %d\n", pad_rec_frames);
+                    pad_rec_desync = 1;
+                }
+                continue;
+            }
+
+            break;
+        }
+
+        if (code == PAD_REC_END)
+        {
+            pad_rec_stop();
+            return;
+        }
+
+        if (code == PAD_REC_DELTA)
+        {
+            mask = pad_rec_get_long();
+
+            for (i = 0; i < PAD_REC_WORDS; i++)
+            {
+                if (mask & (1 << i))
+                {
+                    pad_rec_last[i] = pad_rec_get();
+                    pad_rec_last[i] |= pad_rec_get() << 8;
+                }
+            }
+        }
+        else
+        {
+            // this frame is the first of the run
+            pad_rec_run = code;
+        }
+    }
+
+    GV_CopyMemory(pad_rec_last, GV_PadData, sizeof(GV_PadData));
+    pad_rec_frames++;
+}
+
+// no buttons and no direction, while a replay waits for a load
+static void pad_rec_neutral(void)
+{
+    GV_PAD *pad;
+    int     i;
+
+    GV_ZeroMemory(GV_PadData, sizeof(GV_PadData));
+
+    pad = GV_PadData;
+    for (i = 4; i > 0; i--, pad++)
+    {
+        pad->dir = -1;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+/* Called when a stage's scenario starts. */
+void GV_PadRecStageStart(void)
+{
+    int request;
+
+    request = pad_rec_request;
+    if (request == 0 || request == PAD_REC_STOP)
+    {
+        return;
+    }
+
+    pad_rec_request = 0;
+    pad_rec_stop();
+
+    pad_rec_frames = 0;
+    pad_rec_run = 0;
+    GV_ZeroMemory(pad_rec_last, sizeof(pad_rec_last));
+
+    if (request == PAD_REC_RECORD)
+    {
+        pad_rec_start_record();
+    }
+    else if (request == PAD_REC_REPLAY)
+    {
+        pad_rec_start_replay();
+    }
+}
+
+/* Called at the end of GV_UpdatePadSystem. */
+void GV_PadRecFrame(void)
+{
+    if (pad_rec_request == PAD_REC_STOP)
+    {
+        pad_rec_request = 0;
+        pad_rec_stop();
+    }
+
+    if (pad_rec_state == PAD_REC_IDLE)
+    {
+        return;
+    }
+
+    if (GM_LoadComplete <= 0)
+    {
+        if (pad_rec_state == PAD_REC_REPLAYING)
+        {
+            pad_rec_neutral();
+        }
+        return;
+    }
+
+    if (pad_rec_state == PAD_REC_RECORDING)
+    {
+        pad_rec_record_frame();
+    }
+    else
+    {
+        pad_rec_replay_frame();
+    }
+}
+
+#endif // DEV_EXE
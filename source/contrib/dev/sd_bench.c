@@ -0,0 +1,221 @@
+/*
+ * Headless sequencer benchmark (dev only).
+ *
+ * Set sd_bench_request (from the debugger or from code) and SdInt runs the
+ * sequencer back to back with the hardware SPU muted via sd_soft_spu:
+ *
+ *   SD_BENCH_SE    every resident sound effect in se_tbl, one at a time
+ *   SD_BENCH_SNG   sd_bench_song (0x01000001..) from the loaded song data
+ *   SD_BENCH_SPUWR per-tick cost of spuwr() with 0, 4 and 21 dirty voices
+ *
+ * For each sound it prints the number of ticks, the time spent in
+ * IntSdMain (sound_sub -> tx_read -> note_cntl -> spuwr) and the
+ * sd_soft_sum checksum of the register writes, which serves as a golden
+ * value when comparing builds. Totals are reported as ticks/s and
+ * voices/s of CPU time.
+ */
+#ifdef DEV_EXE
+
+#include "sd/sd_incl.h"
+#include "sd/sd_ext.h"
+
+#include <stdio.h>
+#include <libapi.h>
+#include <libspu.h>
+#include "common.h"
+
+#define SD_BENCH_MAX_TICKS  3600    /* one minute of SdInt ticks */
+#define SD_BENCH_HSYNC_HZ   15734   /* RCntCNT1 counts hsyncs (NTSC) */
+#define SD_BENCH_SE_TRACKS  0x1FE000
+#define SD_BENCH_SNG_TRACKS 0x1FFF
+#define SD_BENCH_SPUWR_REPS 256
+
+extern unsigned char se_dummy[];
+
+int sd_bench_request;
+int sd_bench_song = 0x01000001;
+
+STATIC int sd_bench_ticks;
+STATIC int sd_bench_hsyncs;
+STATIC int sd_bench_voices;
+
+/* count per second of CPU time, without overflowing on long runs */
+static int sd_bench_rate(int count, int hsyncs)
+{
+    int msec;
+
+    msec = (hsyncs * 10) / (SD_BENCH_HSYNC_HZ / 100);
+    if (msec == 0)
+    {
+        return 0;
+    }
+
+    return (count / msec) * 1000 + ((count % msec) * 1000) / msec;
+}
+
+static int sd_bench_se_pending(void)
+{
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        if (se_request[i].code)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* Runs IntSdMain until every track in end_mask has ended. */
+static void sd_bench_run(const char *name, int code, unsigned long end_mask)
+{
+    long intime, outtime;
+    int  ticks, hsyncs, voices;
+
+    sd_soft_sum = 0;
+    hsyncs = 0;
+    voices = sd_soft_voice_ticks;
+
+    for (ticks = 0; ticks < SD_BENCH_MAX_TICKS; ticks++)
+    {
+        intime = GetRCnt(RCntCNT1);
+        IntSdMain();
+        outtime = GetRCnt(RCntCNT1);
+        hsyncs += (outtime - intime) & 0xffff;
+
+        sd_soft_tick();
+
+        if ((song_end & end_mask) == end_mask && !sd_bench_se_pending())
+        {
+            ticks++;
+            break;
+        }
+    }
+
+    voices = sd_soft_voice_ticks - voices;
+
+    printf("%s %08X: ticks %d hsync %d voices %d sum %08X\n",
+           name, code, ticks, hsyncs, voices, (unsigned int)sd_soft_sum);
+
+    sd_bench_ticks += ticks;
+    sd_bench_hsyncs += hsyncs;
+    sd_bench_voices += voices;
+}
+
+static void sd_bench_se(void)
+{
+    int i;
+
+    for (i = 1; i < 128; i++)
+    {
+        if (se_tbl[i].addr[0] == se_dummy)
+        {
+            continue;
+        }
+
+        SePlay(i);
+        sd_bench_run("se", i, SD_BENCH_SE_TRACKS);
+    }
+}
+
+static void sd_bench_sng(void)
+{
+    if (sng_status < 2)
+    {
+        printf("sd_bench: no song loaded (sng_status=%x)\n", sng_status);
+        return;
+    }
+
+    sd_set(sd_bench_song);
+    sd_bench_run("sng", sd_bench_song, SD_BENCH_SNG_TRACKS);
+
+    sd_set(0x01FFFFFF);
+    IntSdMain();
+}
+
+/*
+ * Re-flags the volume and pitch of the first 'voices' tracks with their
+ * current values, so the hardware sees no change while spuwr() does the
+ * full amount of work for them.
+ */
+static void sd_bench_spuwr_voices(int voices)
+{
+    long intime, outtime;
+    int  hsyncs;
+    int  rep, i;
+
+    hsyncs = 0;
+
+    for (rep = 0; rep < SD_BENCH_SPUWR_REPS; rep++)
+    {
+        for (i = 0; i < voices; i++)
+        {
+            spu_tr_wk[i].vol_fg = 1;
+            spu_tr_wk[i].pitch_fg = 1;
+            SD_SET_DIRTY(i);
+        }
+
+        intime = GetRCnt(RCntCNT1);
+        spuwr();
+        outtime = GetRCnt(RCntCNT1);
+        hsyncs += (outtime - intime) & 0xffff;
+    }
+
+    printf("spuwr %2d voices: %d.%02d hsync/tick\n", voices,
+           hsyncs / SD_BENCH_SPUWR_REPS,
+           ((hsyncs % SD_BENCH_SPUWR_REPS) * 100) / SD_BENCH_SPUWR_REPS);
+}
+
+static void sd_bench_spuwr(void)
+{
+    // time the real register writes, not the software model
+    sd_soft_spu = 0;
+
+    sd_bench_spuwr_voices(0);
+    sd_bench_spuwr_voices(4);
+    sd_bench_spuwr_voices(21);
+}
+
+void sd_bench_run_request(void)
+{
+    int request;
+    int old_soft_spu;
+
+    request = sd_bench_request;
+    sd_bench_request = 0;
+
+    old_soft_spu = sd_soft_spu;
+    sd_soft_spu = 1;
+
+    sd_bench_ticks = 0;
+    sd_bench_hsyncs = 0;
+    sd_bench_voices = 0;
+
+    printf("--sd_bench %d--\n", request);
+
+    switch (request)
+    {
+    case SD_BENCH_SE:
+        sd_bench_se();
+        break;
+
+    case SD_BENCH_SNG:
+        sd_bench_sng();
+        break;
+
+    case SD_BENCH_SPUWR:
+        sd_bench_spuwr();
+        break;
+    }
+
+    printf("sd_bench: ticks %d hsync %d ticks/s %d voices/s %d\n",
+           sd_bench_ticks, sd_bench_hsyncs,
+           sd_bench_rate(sd_bench_ticks, sd_bench_hsyncs),
+           sd_bench_rate(sd_bench_voices, sd_bench_hsyncs));
+
+    sd_soft_spu = old_soft_spu;
+}
+
+#endif // DEV_EXE
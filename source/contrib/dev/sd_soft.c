@@ -0,0 +1,328 @@
+/*
+ * Software model of the SPU voice registers (dev only).
+ *
+ * Every SpuSetKey and SpuSetVoiceAttr call of the driver (spuwr, keyOn,
+ * keyOff, sd_init, SdTerm, the stream start, fade and stop paths) is routed
+ * through here. Reads (SpuGetKeyStatus, SpuGetVoiceAttr), the reverb and
+ * common attributes and SPU transfers still go to the hardware.
+ * Every write is mirrored into sd_soft_voice[] and the ADSR envelopes are
+ * stepped once per SdInt tick, which makes it possible to follow what the
+ * sequencer asks of the SPU and to run it with the hardware muted
+ * (sd_soft_spu = 1). sd_soft_sum folds every write into a running
+ * checksum that can be compared between builds.
+ *
+ * The envelope model follows the SPU rate formula but advances in
+ * SD_SOFT_STEPS slices per tick rather than per sample, so levels are
+ * close to, not identical to, the hardware.
+ */
+#ifdef DEV_EXE
+
+#include "sd/sd_incl.h"
+#include "sd/sd_ext.h"
+
+#include <stdio.h>
+#include <libspu.h>
+#include "common.h"
+
+#define SD_SOFT_TICK_SAMPLES    735     /* 44100 Hz / 60 Hz */
+#define SD_SOFT_STEPS           8
+#define SD_SOFT_ENV_MAX         0x7FFF
+
+SD_SOFT_VOICE   sd_soft_voice[SD_SOFT_VOICES];
+int             sd_soft_spu;            /* 1: don't touch the hardware SPU */
+unsigned long   sd_soft_keys;           /* voices with a running envelope */
+int             sd_soft_attr_writes;
+int             sd_soft_key_writes;
+int             sd_soft_ticks;
+int             sd_soft_voice_ticks;
+unsigned long   sd_soft_sum;
+
+#define SD_SOFT_SUM(x)  (sd_soft_sum = sd_soft_sum * 31 + (unsigned long)(x))
+
+static int sd_soft_is_decrease(long mode)
+{
+    return mode == SPU_VOICE_LINEARDecN ||
+           mode == SPU_VOICE_LINEARDecR ||
+           mode == SPU_VOICE_EXPDec;
+}
+
+static int sd_soft_is_exp(long mode)
+{
+    return mode == SPU_VOICE_EXPIncN ||
+           mode == SPU_VOICE_EXPIncR ||
+           mode == SPU_VOICE_EXPDec;
+}
+
+/* Advances one envelope level by 'samples' samples at the given rate. */
+static int sd_soft_env_step(int level, int rate, long mode, int samples)
+{
+    int shift;
+    int step;
+    int cycles;
+    int delta;
+
+    shift = rate >> 2;
+
+    if (sd_soft_is_decrease(mode))
+    {
+        step = -8 + (rate & 3);
+    }
+    else
+    {
+        step = 7 - (rate & 3);
+    }
+
+    if (shift < 11)
+    {
+        step <<= 11 - shift;
+        cycles = 1;
+    }
+    else
+    {
+        cycles = 1 << (shift - 11);
+    }
+
+    if (sd_soft_is_exp(mode))
+    {
+        if (step < 0)
+        {
+            step = (step * level) >> 15;
+        }
+        else if (level > 0x6000)
+        {
+            cycles <<= 2;
+        }
+    }
+
+    delta = (step * samples) / cycles;
+    level += delta;
+
+    if (level < 0)
+    {
+        level = 0;
+    }
+    else if (level > SD_SOFT_ENV_MAX)
+    {
+        level = SD_SOFT_ENV_MAX;
+    }
+
+    return level;
+}
+
+static void sd_soft_voice_step(SD_SOFT_VOICE *vp, int samples)
+{
+    int sustain;
+
+    switch (vp->phase)
+    {
+    case SD_SOFT_ATTACK:
+        vp->env = sd_soft_env_step(vp->env, vp->ar, vp->a_mode, samples);
+        if (vp->env >= SD_SOFT_ENV_MAX)
+        {
+            vp->phase = SD_SOFT_DECAY;
+        }
+        break;
+
+    case SD_SOFT_DECAY:
+        sustain = (vp->sl + 1) << 11;
+        vp->env = sd_soft_env_step(vp->env, vp->dr << 2, SPU_VOICE_EXPDec, samples);
+        if (vp->env <= sustain)
+        {
+            vp->env = sustain;
+            vp->phase = SD_SOFT_SUSTAIN;
+        }
+        break;
+
+    case SD_SOFT_SUSTAIN:
+        vp->env = sd_soft_env_step(vp->env, vp->sr, vp->s_mode, samples);
+        break;
+
+    case SD_SOFT_RELEASE:
+        vp->env = sd_soft_env_step(vp->env, vp->rr << 2, vp->r_mode, samples);
+        if (vp->env == 0)
+        {
+            vp->phase = SD_SOFT_OFF;
+        }
+        break;
+    }
+}
+
+void sd_soft_set_voice_attr(SpuVoiceAttr *attr)
+{
+    SD_SOFT_VOICE *vp;
+    unsigned long  mask;
+    int            i;
+
+    sd_soft_attr_writes++;
+
+    mask = attr->mask;
+    SD_SOFT_SUM(attr->voice);
+    SD_SOFT_SUM(mask);
+
+    vp = sd_soft_voice;
+
+    for (i = 0; i < SD_SOFT_VOICES; i++, vp++)
+    {
+        if (!(attr->voice & (1 << i)))
+        {
+            continue;
+        }
+
+        if (mask & SPU_VOICE_VOLL)
+        {
+            vp->vol_l = attr->volume.left;
+            SD_SOFT_SUM(vp->vol_l);
+        }
+        if (mask & SPU_VOICE_VOLR)
+        {
+            vp->vol_r = attr->volume.right;
+            SD_SOFT_SUM(vp->vol_r);
+        }
+        if (mask & SPU_VOICE_PITCH)
+        {
+            vp->pitch = attr->pitch;
+            SD_SOFT_SUM(vp->pitch);
+        }
+        if (mask & SPU_VOICE_WDSA)
+        {
+            vp->addr = attr->addr;
+            SD_SOFT_SUM(vp->addr);
+        }
+        if (mask & SPU_VOICE_ADSR_AMODE)
+        {
+            vp->a_mode = attr->a_mode;
+        }
+        if (mask & SPU_VOICE_ADSR_SMODE)
+        {
+            vp->s_mode = attr->s_mode;
+        }
+        if (mask & SPU_VOICE_ADSR_RMODE)
+        {
+            vp->r_mode = attr->r_mode;
+        }
+        if (mask & SPU_VOICE_ADSR_AR)
+        {
+            vp->ar = attr->ar;
+        }
+        if (mask & SPU_VOICE_ADSR_DR)
+        {
+            vp->dr = attr->dr;
+        }
+        if (mask & SPU_VOICE_ADSR_SR)
+        {
+            vp->sr = attr->sr;
+        }
+        if (mask & SPU_VOICE_ADSR_SL)
+        {
+            vp->sl = attr->sl;
+        }
+        if (mask & SPU_VOICE_ADSR_RR)
+        {
+            vp->rr = attr->rr;
+        }
+    }
+
+    if (!sd_soft_spu)
+    {
+        SpuSetVoiceAttr(attr);
+    }
+}
+
+void sd_soft_set_key(long on_off, unsigned long voice_bit)
+{
+    SD_SOFT_VOICE *vp;
+    int            i;
+
+    sd_soft_key_writes++;
+    SD_SOFT_SUM(on_off);
+    SD_SOFT_SUM(voice_bit);
+
+    vp = sd_soft_voice;
+    for (i = 0; i < SD_SOFT_VOICES; i++, vp++)
+    {
+        if (!(voice_bit & (1 << i)))
+        {
+            continue;
+        }
+
+        if (on_off == SPU_ON)
+        {
+            vp->phase = SD_SOFT_ATTACK;
+            vp->env = 0;
+            vp->samples = 0;
+        }
+        else if (vp->phase != SD_SOFT_OFF)
+        {
+            vp->phase = SD_SOFT_RELEASE;
+        }
+    }
+
+    if (!sd_soft_spu)
+    {
+        SpuSetKey(on_off, voice_bit);
+    }
+}
+
+/* Called once per SdInt tick. */
+void sd_soft_tick(void)
+{
+    SD_SOFT_VOICE *vp;
+    unsigned long  keys;
+    int            samples;
+    int            i, j;
+
+    samples = SD_SOFT_TICK_SAMPLES / SD_SOFT_STEPS;
+    keys = 0;
+
+    vp = sd_soft_voice;
+    for (i = 0; i < SD_SOFT_VOICES; i++, vp++)
+    {
+        if (vp->phase == SD_SOFT_OFF)
+        {
+            continue;
+        }
+
+        for (j = 0; j < SD_SOFT_STEPS; j++)
+        {
+            sd_soft_voice_step(vp, samples);
+        }
+
+        // pitch 0x1000 plays one source sample per output sample
+        vp->samples += (vp->pitch * SD_SOFT_TICK_SAMPLES) >> 12;
+
+        if (vp->phase != SD_SOFT_OFF)
+        {
+            keys |= 1 << i;
+            sd_soft_voice_ticks++;
+        }
+    }
+
+    sd_soft_keys = keys;
+    sd_soft_ticks++;
+}
+
+void sd_soft_dump(void)
+{
+    static const char *phase_name[] = { "off", "atk", "dec", "sus", "rel" };
+    SD_SOFT_VOICE     *vp;
+    int                i;
+
+    printf("soft spu: ticks %d voice-ticks %d attr %d key %d sum %08X\n",
+           sd_soft_ticks, sd_soft_voice_ticks, sd_soft_attr_writes, sd_soft_key_writes,
+           (unsigned int)sd_soft_sum);
+
+    vp = sd_soft_voice;
+    for (i = 0; i < SD_SOFT_VOICES; i++, vp++)
+    {
+        if (vp->phase == SD_SOFT_OFF)
+        {
+            continue;
+        }
+
+        printf("%2d %s env %04X vol %04X/%04X pitch %04X addr %05X smp %d\n",
+               i, phase_name[vp->phase], vp->env, vp->vol_l, vp->vol_r,
+               vp->pitch, (unsigned int)vp->addr, (int)vp->samples);
+    }
+}
+
+#endif // DEV_EXE
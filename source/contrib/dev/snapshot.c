@@ -0,0 +1,593 @@
+/*
+ * Game state snapshots (dev only).
+ *
+ * The game state is checksummed with GCL_CrcUpdate in SNAP_BLOCK sized
+ * blocks: the link and GCL variables, the area history, the normal heap's
+ * allocation table, the actor lists, the dynamic segments and floors of
+ * every hazard handler and last the normal heap's memory, whose tail goes
+ * unchecked if it doesn't fit in SNAP_MAX_BLOCKS. The blocks are spread over snap_frames
+ * frames so no single frame pays for the whole heap, and at the end of each
+ * interval a record holding only the blocks whose CRC changed is produced.
+ *
+ * Set snap_request (from the debugger or from code) and the session starts
+ * with the next stage's scenario, as pad_rec does:
+ *
+ *   SNAP_RECORD    write a record every interval to snap_file on the host
+ *   SNAP_COMPARE   read snap_file back, and print the first interval, region
+ *                  and block whose CRC differs from the recorded run
+ *   SNAP_STOP      end either mode
+ *
+ * With a pad_rec replay this bounds a divergence between two runs to one
+ * interval and one block of memory. The file is a SNAP_HEADER followed by
+ * records:
+ *
+ *   frame (4 bytes), CRC of all the block CRCs (4 bytes), then for every
+ *   region with changes: region (1 byte), count (2 bytes), and count times
+ *   block (2 bytes) and CRC (4 bytes); SNAP_END_RECORD ends the record
+ */
+#ifdef DEV_EXE
+
+#include <stdio.h>
+#include "common.h"
+#include "libgv/libgv.h"
+#include "libgcl/libgcl.h"
+#include "libhzd/libhzd.h"
+#include "game/game.h"
+#include "game/map.h"
+
+extern int PCopen(const char *name /*, int flags, int perms*/);
+extern int PCcreat(char *name /*, int perms */);
+extern int PCread(int fd, char *buff, int len);
+extern int PCwrite(int fd, char *buff, int len);
+extern int PCclose(int fd);
+
+extern short     linkvarbuf[0x60];
+extern GCL_Vars  gGcl_vars_800B3CC8;
+extern GV_HEAP   MemorySystems_800AD2F0[GV_MEMORY_MAX];
+extern ActorList gActorsList_800ACC18[GV_ACTOR_LEVEL];
+
+#define SNAP_MAGIC          0x50414E53  /* "SNAP" */
+#define SNAP_VERSION        2
+#define SNAP_BLOCK          1024
+#define SNAP_MAX_BLOCKS     512
+#define SNAP_ACTORS         256
+#define SNAP_HZD_SIZE       0x1000
+#define SNAP_BUF_SIZE       0x1000
+#define SNAP_END_RECORD     0xFF
+
+typedef struct SNAP_HEADER
+{
+    unsigned long magic;
+    unsigned long version;
+    unsigned long blocks;
+    unsigned long block_size;
+} SNAP_HEADER;
+
+typedef struct SNAP_REGION
+{
+    const char    *name;
+    unsigned char *base;
+    int            size;
+    int            first;       // index of the region's first block
+} SNAP_REGION;
+
+enum {
+    SNAP_IDLE,
+    SNAP_RECORDING,
+    SNAP_COMPARING
+};
+
+int  snap_request;
+int  snap_frames = 60;
+char snap_file[16] = "SNAP.DAT";
+
+STATIC int snap_state;
+STATIC int snap_fd = -1;
+STATIC int snap_frame;
+STATIC int snap_next;           // next block to checksum this interval
+STATIC int snap_blocks;
+STATIC int snap_differs;
+
+STATIC unsigned long snap_crc[SNAP_MAX_BLOCKS];    // this interval
+STATIC unsigned long snap_last[SNAP_MAX_BLOCKS];   // last record written or read
+STATIC unsigned long snap_ref[SNAP_MAX_BLOCKS];    // the recorded run, when comparing
+
+STATIC AreaHistory   snap_area;
+STATIC unsigned long snap_actors[SNAP_ACTORS * 2];
+STATIC unsigned char snap_hzd[SNAP_HZD_SIZE];
+
+STATIC unsigned char snap_buf[SNAP_BUF_SIZE];
+STATIC int           snap_pos;
+STATIC int           snap_len;
+
+STATIC SNAP_REGION snap_regions[] = {
+    {"linkvar"},
+    {"gclvar"},
+    {"area"},
+    {"heapinfo"},
+    {"actors"},
+    {"hzd"},
+    {"heap"},
+};
+
+#define SNAP_REGIONS    (sizeof(snap_regions) / sizeof(snap_regions[0]))
+
+/*---------------------------------------------------------------------------*/
+
+static void snap_flush(void)
+{
+    if (snap_pos > 0)
+    {
+        PCwrite(snap_fd, (char *)snap_buf, snap_pos);
+        snap_pos = 0;
+    }
+}
+
+static void snap_put(int byte)
+{
+    if (snap_pos >= SNAP_BUF_SIZE)
+    {
+        snap_flush();
+    }
+
+    snap_buf[snap_pos++] = byte;
+}
+
+static void snap_put_short(int value)
+{
+    snap_put(value);
+    snap_put(value >> 8);
+}
+
+static void snap_put_long(unsigned long value)
+{
+    snap_put_short(value);
+    snap_put_short(value >> 16);
+}
+
+static int snap_get(void)
+{
+    if (snap_pos >= snap_len)
+    {
+        snap_len = PCread(snap_fd, (char *)snap_buf, SNAP_BUF_SIZE);
+        snap_pos = 0;
+
+        if (snap_len <= 0)
+        {
+            snap_len = 0;
+            return -1;
+        }
+    }
+
+    return snap_buf[snap_pos++];
+}
+
+static int snap_get_short(void)
+{
+    int value;
+
+    value = snap_get();
+    value |= snap_get() << 8;
+    return value & 0xffff;
+}
+
+static unsigned long snap_get_long(void)
+{
+    unsigned long value;
+
+    value = snap_get_short();
+    value |= snap_get_short() << 16;
+    return value;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void snap_init_regions(void)
+{
+    GV_HEAP *heap;
+    int      i, first;
+
+    heap = &MemorySystems_800AD2F0[GV_NORMAL_MEMORY];
+
+    snap_regions[0].base = (unsigned char *)linkvarbuf;
+    snap_regions[0].size = sizeof(linkvarbuf);
+    snap_regions[1].base = (unsigned char *)&gGcl_vars_800B3CC8;
+    snap_regions[1].size = sizeof(gGcl_vars_800B3CC8);
+    snap_regions[2].base = (unsigned char *)&snap_area;
+    snap_regions[2].size = sizeof(snap_area);
+    snap_regions[3].base = (unsigned char *)heap;
+    snap_regions[3].size = sizeof(GV_HEAP);
+    snap_regions[4].base = (unsigned char *)snap_actors;
+    snap_regions[4].size = sizeof(snap_actors);
+    snap_regions[5].base = snap_hzd;
+    snap_regions[5].size = sizeof(snap_hzd);
+
+    // the heap goes last, so it is the only region cut short
+    snap_regions[6].base = heap->start;
+    snap_regions[6].size = (char *)heap->end - (char *)heap->start;
+
+    first = 0;
+    for (i = 0; i < SNAP_REGIONS; i++)
+    {
+        snap_regions[i].first = first;
+        first += (snap_regions[i].size + SNAP_BLOCK - 1) / SNAP_BLOCK;
+
+        if (first > SNAP_MAX_BLOCKS)
+        {
+            // the tail of the heap goes unchecked
+            snap_regions[i].size -= (first - SNAP_MAX_BLOCKS) * SNAP_BLOCK;
+            first = SNAP_MAX_BLOCKS;
+        }
+    }
+
+    snap_blocks = first;
+}
+
+/* The state that isn't one piece of memory is copied to a buffer first */
+static void snap_capture(void)
+{
+    ActorList     *lp;
+    GV_ACT        *actor;
+    HZD_HDL       *hzd;
+    unsigned long *out;
+    unsigned char *ptr, *end;
+    int            i, n;
+
+    GM_GetAreaHistory(&snap_area);
+
+    GV_ZeroMemory(snap_actors, sizeof(snap_actors));
+    out = snap_actors;
+    n = SNAP_ACTORS;
+
+    lp = gActorsList_800ACC18;
+    for (i = GV_ACTOR_LEVEL; i > 0; i--, lp++)
+    {
+        for (actor = lp->first.next; actor != &lp->last && n > 0; actor = actor->next, n--)
+        {
+            *out++ = (unsigned long)actor;
+            *out++ = (unsigned long)actor->act;
+        }
+    }
+
+    GV_ZeroMemory(snap_hzd, sizeof(snap_hzd));
+    ptr = snap_hzd;
+    end = snap_hzd + sizeof(snap_hzd);
+
+    for (hzd = GM_IterHazard(NULL); hzd; hzd = GM_IterHazard(hzd))
+    {
+        // each segment takes 4 bytes for its flags, to keep the pointers aligned
+        n = hzd->dynamic_queue_index * (sizeof(HZD_SEG *) + sizeof(HZD_SEG) + 4) +
+            hzd->dynamic_floor_index * sizeof(HZD_FLR *) + 4;
+
+        if (ptr + n > end)
+        {
+            break;
+        }
+
+        *(short *)ptr = hzd->dynamic_queue_index;
+        *(short *)(ptr + 2) = hzd->dynamic_floor_index;
+        ptr += 4;
+
+        for (i = 0; i < hzd->dynamic_queue_index; i++)
+        {
+            *(HZD_SEG **)ptr = hzd->dynamic_segments[i];
+            ptr += sizeof(HZD_SEG *);
+            GV_CopyMemory(hzd->dynamic_segments[i], ptr, sizeof(HZD_SEG));
+            ptr += sizeof(HZD_SEG);
+            ptr[0] = hzd->dynamic_flags[i];
+            ptr[1] = hzd->dynamic_flags[i + hzd->max_dynamic_segments];
+            ptr += 4;
+        }
+
+        for (i = 0; i < hzd->dynamic_floor_index; i++)
+        {
+            *(HZD_FLR **)ptr = hzd->dynamic_floors[i];
+            ptr += sizeof(HZD_FLR *);
+        }
+    }
+}
+
+static int snap_region_of(int block)
+{
+    int i;
+
+    for (i = SNAP_REGIONS - 1; i > 0; i--)
+    {
+        if (block >= snap_regions[i].first)
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+static void snap_checksum(int block)
+{
+    SNAP_REGION *region;
+    int          offset, len;
+
+    region = &snap_regions[snap_region_of(block)];
+    offset = (block - region->first) * SNAP_BLOCK;
+    len = region->size - offset;
+    if (len > SNAP_BLOCK)
+    {
+        len = SNAP_BLOCK;
+    }
+
+    snap_crc[block] = GCL_CrcUpdate(0xffffffff, region->base + offset, len);
+}
+
+/*---------------------------------------------------------------------------*/
+
+static unsigned long snap_total(unsigned long *crcs)
+{
+    return ~GCL_CrcUpdate(0xffffffff, (unsigned char *)crcs, snap_blocks * sizeof(unsigned long));
+}
+
+static void snap_write_record(void)
+{
+    int region, block, end, count;
+
+    snap_put_long(snap_frame);
+    snap_put_long(snap_total(snap_crc));
+
+    for (region = 0; region < SNAP_REGIONS; region++)
+    {
+        block = snap_regions[region].first;
+        end = (region + 1 < SNAP_REGIONS) ? snap_regions[region + 1].first : snap_blocks;
+
+        count = 0;
+        for (; block < end; block++)
+        {
+            if (snap_crc[block] != snap_last[block])
+            {
+                count++;
+            }
+        }
+
+        if (count == 0)
+        {
+            continue;
+        }
+
+        snap_put(region);
+        snap_put_short(count);
+
+        for (block = snap_regions[region].first; block < end; block++)
+        {
+            if (snap_crc[block] != snap_last[block])
+            {
+                snap_put_short(block);
+                snap_put_long(snap_crc[block]);
+                snap_last[block] = snap_crc[block];
+            }
+        }
+    }
+
+    snap_put(SNAP_END_RECORD);
+}
+
+/* Returns 0 at the end of the recorded run */
+static int snap_read_record(void)
+{
+    int           region, count, block;
+    unsigned long crc;
+
+    if (snap_get_long() != snap_frame)
+    {
+        return 0;
+    }
+
+    snap_get_long();
+
+    for (;;)
+    {
+        region = snap_get();
+        if (region == SNAP_END_RECORD || region < 0)
+        {
+            break;
+        }
+
+        for (count = snap_get_short(); count > 0; count--)
+        {
+            block = snap_get_short();
+            crc = snap_get_long();
+
+            if (block < SNAP_MAX_BLOCKS)
+            {
+                snap_ref[block] = crc;
+            }
+        }
+    }
+
+    return region == SNAP_END_RECORD;
+}
+
+static void snap_compare(void)
+{
+    SNAP_REGION *region;
+    int          block;
+
+    if (!snap_read_record())
+    {
+        printf("snap: end of %s at frame %d\n", snap_file, snap_frame);
+        snap_request = SNAP_STOP;
+        return;
+    }
+
+    for (block = 0; block < snap_blocks; block++)
+    {
+        if (snap_crc[block] != snap_ref[block])
+        {
+            break;
+        }
+    }
+
+    if (block == snap_blocks)
+    {
+        return;
+    }
+
+    region = &snap_regions[snap_region_of(block)];
+    printf("snap: differs by frame %d, %s block %d (%08lX)\n", snap_frame, region->name,
+           block - region->first, (unsigned long)region->base + (block - region->first) * SNAP_BLOCK);
+
+    // only the first one counts, the rest follows from it
+    snap_differs = 1;
+    snap_request = SNAP_STOP;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void snap_stop(void)
+{
+    switch (snap_state)
+    {
+    case SNAP_RECORDING:
+        snap_flush();
+        printf("snap: recorded %d frames to %s\n", snap_frame, snap_file);
+        break;
+
+    case SNAP_COMPARING:
+        printf("snap: compared %d frames, %s\n", snap_frame, snap_differs ? "differs" : "same");
+        break;
+    }
+
+    if (snap_fd >= 0)
+    {
+        PCclose(snap_fd);
+        snap_fd = -1;
+    }
+
+    snap_state = SNAP_IDLE;
+}
+
+static void snap_start(int request)
+{
+    SNAP_HEADER header;
+
+    snap_init_regions();
+
+    if (request == SNAP_RECORD)
+    {
+        snap_fd = PCcreat(snap_file);
+        if (snap_fd < 0)
+        {
+            printf("snap: can't create %s\n", snap_file);
+            return;
+        }
+
+        header.magic = SNAP_MAGIC;
+        header.version = SNAP_VERSION;
+        header.blocks = snap_blocks;
+        header.block_size = SNAP_BLOCK;
+        PCwrite(snap_fd, (char *)&header, sizeof(header));
+
+        snap_state = SNAP_RECORDING;
+    }
+    else
+    {
+        snap_fd = PCopen(snap_file);
+        if (snap_fd < 0)
+        {
+            printf("snap: can't open %s\n", snap_file);
+            return;
+        }
+
+        if (PCread(snap_fd, (char *)&header, sizeof(header)) != sizeof(header) ||
+            header.magic != SNAP_MAGIC || header.version != SNAP_VERSION ||
+            header.blocks != snap_blocks || header.block_size != SNAP_BLOCK)
+        {
+            printf("snap: %s doesn't match this build\n", snap_file);
+            PCclose(snap_fd);
+            snap_fd = -1;
+            return;
+        }
+
+        snap_len = 0;
+        snap_differs = 0;
+        snap_state = SNAP_COMPARING;
+    }
+
+    snap_pos = 0;
+    snap_frame = 0;
+    snap_next = 0;
+
+    GV_ZeroMemory(snap_last, sizeof(snap_last));
+    GV_ZeroMemory(snap_ref, sizeof(snap_ref));
+
+    printf("snap: %d blocks over %d frames\n", snap_blocks, snap_frames);
+}
+
+/*---------------------------------------------------------------------------*/
+
+/* Called when a stage's scenario starts. */
+void GCL_SnapStageStart(void)
+{
+    int request;
+
+    request = snap_request;
+    if (request == 0 || request == SNAP_STOP)
+    {
+        return;
+    }
+
+    snap_request = 0;
+    snap_stop();
+    snap_start(request);
+}
+
+/* Called once per frame from the game actor, in a stage. */
+void GCL_SnapFrame(void)
+{
+    int per_frame;
+    int i;
+
+    if (snap_request == SNAP_STOP)
+    {
+        snap_request = 0;
+        snap_stop();
+    }
+
+    if (snap_state == SNAP_IDLE)
+    {
+        return;
+    }
+
+    if (snap_frames < 1)
+    {
+        snap_frames = 1;
+    }
+
+    if (snap_next == 0)
+    {
+        snap_capture();
+    }
+
+    per_frame = (snap_blocks + snap_frames - 1) / snap_frames;
+    for (i = per_frame; i > 0 && snap_next < snap_blocks; i--)
+    {
+        snap_checksum(snap_next++);
+    }
+
+    snap_frame++;
+
+    if (snap_frame % snap_frames != 0)
+    {
+        return;
+    }
+
+    if (snap_state == SNAP_RECORDING)
+    {
+        snap_write_record();
+    }
+    else
+    {
+        snap_compare();
+    }
+
+    snap_next = 0;
+}
+
+#endif // DEV_EXE
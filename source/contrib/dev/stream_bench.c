@@ -0,0 +1,311 @@
+/*
+ * Stream ring benchmark (dev only).
+ *
+ * Set stream_bench_request to a number of sectors per frame (a 2x CD reads
+ * 2.5) while no stream is playing, and the next game frame plays a
+ * synthetic stream through libfs/stream.c on a heap of its own. The
+ * producer stands in for the CD through fs_stream_producer and hands
+ * StreamReadyCallback that many sectors per frame. FS_StreamSync then runs
+ * as strctrl does, and the consumers take one demo (5), voice (1) and
+ * subtitle (3) packet each per frame, as the demo, sound and jimaku
+ * threads would.
+ *
+ * The stream holds STREAM_BENCH_FRAMES frames of packets. The report gives
+ * the bytes taken per frame for each type, the frames a consumer found
+ * nothing, the ring wraps and the hsyncs per frame spent in the
+ * callback, in FS_StreamSync and in FS_StreamGetData. The time taken to
+ * build the synthetic sectors is not counted.
+ */
+#ifdef DEV_EXE
+
+#include <stdio.h>
+#include <libapi.h>
+#include "common.h"
+#include "libgv/libgv.h"
+#include "libfs/libfs.h"
+
+#define STREAM_BENCH_FRAMES     600     /* frames of packets in the stream */
+#define STREAM_BENCH_MAX_FRAMES 6000
+#define STREAM_BENCH_MAX_SECTORS 16
+#define STREAM_BENCH_MIN_HEAP   (FS_SECTOR_SIZE * 8)
+#define STREAM_BENCH_TYPES      3
+
+extern int   fs_stream_read;
+extern void *fs_stream_heap;
+extern char *fs_stream_heap_end;
+extern int   fs_stream_heap_size;
+extern int   fs_stream_task_state;
+
+int stream_bench_request;
+
+STATIC const int stream_bench_type[STREAM_BENCH_TYPES] = {5, 1, 3};
+STATIC const int stream_bench_size[STREAM_BENCH_TYPES] = {0x200, 0x800, 0x300};
+STATIC const int stream_bench_every[STREAM_BENCH_TYPES] = {1, 1, 30};   /* frames */
+
+STATIC CDBIOS_TASK stream_bench_task;
+STATIC int         stream_bench_reading;
+
+/* where the packet generator is */
+STATIC int stream_bench_frame;
+STATIC int stream_bench_packet;
+STATIC int stream_bench_offset;
+STATIC int stream_bench_done;
+
+static void stream_bench_producer(void *buffer, int sector, cdbios_task_pfn callback)
+{
+    stream_bench_task.buffer = buffer;
+    stream_bench_task.sector = sector;
+    stream_bench_task.callback = callback;
+    stream_bench_reading = 1;
+}
+
+/* Returns the next packet of the stream, or -1 once it has ended */
+static int stream_bench_next_packet(void)
+{
+    for (; stream_bench_frame < STREAM_BENCH_FRAMES; stream_bench_frame++, stream_bench_packet = 0)
+    {
+        for (; stream_bench_packet < STREAM_BENCH_TYPES; stream_bench_packet++)
+        {
+            if (stream_bench_frame % stream_bench_every[stream_bench_packet] == 0)
+            {
+                return stream_bench_packet;
+            }
+        }
+    }
+
+    return -1;
+}
+
+/* Writes one sector of the stream, as the CD would deliver it */
+static void stream_bench_fill(int *sector)
+{
+    int i;
+    int packet;
+    int size;
+
+    for (i = 0; i < FS_SECTOR_SIZE / 4; i++)
+    {
+        if (stream_bench_done)
+        {
+            sector[i] = 0;
+            continue;
+        }
+
+        packet = stream_bench_next_packet();
+        if (packet < 0)
+        {
+            // the end tag, see StreamReadyCallback
+            sector[i] = 0xF0;
+            stream_bench_done = 1;
+            continue;
+        }
+
+        size = stream_bench_size[packet];
+
+        if (stream_bench_offset == 0)
+        {
+            sector[i] = (size << 8) | stream_bench_type[packet];
+        }
+        else
+        {
+            sector[i] = stream_bench_frame;
+        }
+
+        stream_bench_offset += 4;
+        if (stream_bench_offset >= size)
+        {
+            stream_bench_offset = 0;
+            stream_bench_packet++;
+        }
+    }
+}
+
+/* Delivers a sector as CDBIOS_ReadyCallback does, returns the callback's status */
+static int stream_bench_deliver(int *hsyncs)
+{
+    long intime;
+    int  status;
+
+    stream_bench_fill(stream_bench_task.buffer);
+    stream_bench_task.buffer_size = FS_SECTOR_SIZE / 4;
+
+    intime = GetRCnt(RCntCNT1);
+    status = stream_bench_task.callback(&stream_bench_task);
+    *hsyncs += (GetRCnt(RCntCNT1) - intime) & 0xffff;
+
+    if (status == 0)
+    {
+        stream_bench_reading = 0;
+    }
+    else if (status == 1)
+    {
+        stream_bench_task.buffer = (int *)stream_bench_task.buffer + FS_SECTOR_SIZE / 4;
+    }
+
+    stream_bench_task.sector++;
+    return status;
+}
+
+static void *stream_bench_alloc_heap(int *size)
+{
+    void *heap;
+
+    for (*size = FS_CDLOAD_BUF_SIZE; *size >= STREAM_BENCH_MIN_HEAP; *size /= 2)
+    {
+        heap = GV_Malloc(*size);
+        if (heap)
+        {
+            return heap;
+        }
+    }
+
+    return NULL;
+}
+
+void FS_StreamBench(void)
+{
+    void *old_heap;
+    char *old_heap_end;
+    int   old_heap_size;
+    void *heap;
+    int   heap_size;
+    int   sectors;
+    int   bytes[STREAM_BENCH_TYPES];
+    int   empty[STREAM_BENCH_TYPES];
+    int   wraps;
+    int   callback_hsyncs, sync_hsyncs, get_hsyncs;
+    void *data;
+    long  intime;
+    int   frames, idle;
+    int   i, j;
+
+    sectors = stream_bench_request;
+    stream_bench_request = 0;
+
+    if (sectors < 1)
+    {
+        sectors = 1;
+    }
+    else if (sectors > STREAM_BENCH_MAX_SECTORS)
+    {
+        sectors = STREAM_BENCH_MAX_SECTORS;
+    }
+
+    if (!FS_StreamIsEnd() || FS_StreamTaskState() != 0 || fs_stream_read)
+    {
+        printf("stream_bench: a stream is playing\n");
+        return;
+    }
+
+    heap = stream_bench_alloc_heap(&heap_size);
+    if (!heap)
+    {
+        printf("stream_bench: no memory\n");
+        return;
+    }
+
+    old_heap = fs_stream_heap;
+    old_heap_end = fs_stream_heap_end;
+    old_heap_size = fs_stream_heap_size;
+
+    fs_stream_heap = heap;
+    fs_stream_heap_size = heap_size;
+    fs_stream_heap_end = (char *)heap + heap_size;
+
+    stream_bench_frame = 0;
+    stream_bench_packet = 0;
+    stream_bench_offset = 0;
+    stream_bench_done = 0;
+    stream_bench_reading = 0;
+
+    for (i = 0; i < STREAM_BENCH_TYPES; i++)
+    {
+        bytes[i] = 0;
+        empty[i] = 0;
+    }
+
+    wraps = 0;
+    callback_hsyncs = 0;
+    sync_hsyncs = 0;
+    get_hsyncs = 0;
+    idle = 0;
+
+    fs_stream_producer = stream_bench_producer;
+    FS_StreamTaskStart(0);
+
+    for (frames = 0; frames < STREAM_BENCH_MAX_FRAMES && idle < 2; frames++)
+    {
+        for (i = 0; i < sectors && stream_bench_reading; i++)
+        {
+            if (stream_bench_deliver(&callback_hsyncs) == 2)
+            {
+                wraps++;
+            }
+        }
+
+        intime = GetRCnt(RCntCNT1);
+        FS_StreamSync();
+        sync_hsyncs += (GetRCnt(RCntCNT1) - intime) & 0xffff;
+
+        // the consumers wait for the preroll, as strctrl does
+        if (FS_StreamTaskState() == -1)
+        {
+            continue;
+        }
+
+        // the run ends once the stream has ended and the packets are gone
+        if (FS_StreamGetEndFlag())
+        {
+            idle++;
+        }
+
+        for (j = 0; j < STREAM_BENCH_TYPES; j++)
+        {
+            intime = GetRCnt(RCntCNT1);
+            data = FS_StreamGetData(stream_bench_type[j]);
+            get_hsyncs += (GetRCnt(RCntCNT1) - intime) & 0xffff;
+
+            if (data)
+            {
+                bytes[j] += FS_StreamGetSize(data);
+                FS_StreamClear(data);
+                idle = 0;
+            }
+            else if (!FS_StreamGetEndFlag() && stream_bench_every[j] == 1)
+            {
+                empty[j]++;
+            }
+        }
+    }
+
+    fs_stream_producer = NULL;
+
+    if (!FS_StreamGetEndFlag())
+    {
+        printf("stream_bench: stopped after %d frames\n", frames);
+    }
+
+    printf("stream_bench %d sectors/frame, %d byte heap, %d frames, %d wraps\n",
+           sectors, heap_size, frames, wraps);
+
+    for (j = 0; j < STREAM_BENCH_TYPES; j++)
+    {
+        printf(" type %d: %d bytes/frame, %d frames empty\n", stream_bench_type[j],
+               bytes[j] / frames, empty[j]);
+    }
+
+    printf(" hsync/frame: callback %d sync %d get %d\n", callback_hsyncs / frames,
+           sync_hsyncs / frames, get_hsyncs / frames);
+
+    // leave the stream idle for the next real one
+    fs_stream_read = 0;
+    fs_stream_task_state = 0;
+
+    fs_stream_heap = old_heap;
+    fs_stream_heap_end = old_heap_end;
+    fs_stream_heap_size = old_heap_size;
+
+    GV_Free(heap);
+}
+
+#endif // DEV_EXE
@@ -180,7 +180,7 @@ CONTROL BSS         gDefaultControl_800B5650; // 0x7C (124) bytes
 
 gap                                     gap_800B56CC[0x4]; // 4 bytes
 
-CONTROL *BSS        GM_WhereList[96]; // 0x180 (384) bytes
+CONTROL *BSS        GM_WhereList[MAX_CONTROLS]; // MAX_CONTROLS * 4: 0x180 (384) bytes, 0x400 (1024) in DEV_EXE
 
 /* game/area.obj */
 AreaHistory BSS     gAreaHistory_800B5850; // 0x10 (16) bytes
@@ -4,6 +4,9 @@
 #include <sys/types.h>
 #include <libgte.h>
 #include <libgpu.h>
+#ifdef DEV_EXE
+#include <libapi.h>     // for GetRCnt
+#endif
 
 #include "common.h"
 #include "libgv/libgv.h"
@@ -30,6 +33,98 @@ char *dword_8009E75C[] = {NULL, NULL, NULL, NULL};
 #define HASH_font   0xCA68  // GV_StrCode("font")
 #define HASH_rubi   0xE0E3  // GV_StrCode("rubi")
 
+#ifdef DEV_EXE
+/*
+ * font_glyph_cache: font_draw_glyph looks up every 2bpp glyph byte in
+ * font_glyph_even/odd, which hold the 4bpp bytes the original bit by bit
+ * loops write for it in each of the 4 palettes. The tables are built by
+ * running those same loops, so the result is identical.
+ *
+ * font_print_cache: font_print_string skips the redraw when the buffer still
+ * holds the same text, printed with the same settings, from the last call.
+ * Any other draw or clear of the buffer forgets it.
+ *
+ * font_keep_lines gives one KCB a store of whole drawn lines, kept with the
+ * same keys. font_layout_string draws a line into the store ahead of time
+ * and font_print_string copies it from there instead of drawing it again.
+ * Changing the font forgets every line.
+ *
+ * font_keep_buffer lets a caller that draws a buffer itself (the codec
+ * choice list) ask with font_buffer_kept whether anything has cleared or
+ * drawn into it since.
+ *
+ * font_layout_*: font_draw_string calls made to print or lay out a line.
+ * font_blit_*: font_update calls, and the hsyncs spent queueing their
+ * LoadImage. The transfer itself runs later and isn't counted.
+ */
+#define FONT_PRINT_ENTRIES  8
+#define FONT_LINE_ENTRIES   8
+
+typedef struct FONT_PRINT
+{
+    void         *buffer;
+    const char   *string;
+    unsigned long sum;
+    short         color;
+    short         ytop;
+    short         option;
+    short         rubi;
+    short         max_width;
+    short         short3;
+} FONT_PRINT;
+
+int font_glyph_cache = 1;
+int font_print_cache = 1;
+int font_print_hits;
+int font_print_misses;
+int font_line_hits;
+int font_layout_count;
+int font_layout_hsyncs;
+int font_blit_count;
+int font_blit_hsyncs;
+
+STATIC u_short    font_glyph_even[4][256];
+STATIC u_long     font_glyph_odd[4][256];
+STATIC int        font_glyph_ready;
+STATIC FONT_PRINT font_print[FONT_PRINT_ENTRIES];
+STATIC int        font_print_next;
+STATIC FONT_PRINT font_line[FONT_LINE_ENTRIES];     /* buffer is the line's copy */
+STATIC int        font_line_next;
+STATIC int        font_line_count;
+STATIC int        font_line_size;
+STATIC char      *font_line_store;
+STATIC void      *font_line_owner;
+STATIC void      *font_kept_buffer;
+
+static void font_forget_print(void *buffer)
+{
+    FONT_PRINT *print;
+    int         i;
+
+    print = font_print;
+    for (i = FONT_PRINT_ENTRIES; i > 0; i--, print++)
+    {
+        if (!buffer || print->buffer == buffer)
+        {
+            print->buffer = NULL;
+        }
+    }
+
+    if (!buffer || buffer == font_kept_buffer)
+    {
+        font_kept_buffer = NULL;
+    }
+
+    if (!buffer)
+    {
+        for (i = 0; i < FONT_LINE_ENTRIES; i++)
+        {
+            font_line[i].buffer = NULL;
+        }
+    }
+}
+#endif
+
 void font_load(void)
 {
     char *temp_a1;
@@ -58,11 +153,18 @@ void font_load(void)
             LSTORE((ptr[0] << 24) | (ptr[1] << 16) | (ptr[2] << 8) | ptr[3], ptr);
         }
     }
+
+#ifdef DEV_EXE
+    font_forget_print(NULL);
+#endif
 }
 
 void font_set_font_addr(int arg1, void *data)
 {
     dword_8009E75C[arg1] = data;
+#ifdef DEV_EXE
+    font_forget_print(NULL);
+#endif
 }
 
 void font_free(void)
@@ -95,6 +197,16 @@ int font_set_kcb(KCB *kcb, int maximum_width, int arg2, int letter_spacing,
     int quotient1;
     int val0;
 
+#ifdef DEV_EXE
+    font_forget_print(kcb->font_buffer);
+
+    // the stored lines were drawn with the old layout
+    if (kcb->font_buffer && kcb->font_buffer == font_line_owner)
+    {
+        font_line_owner = NULL;
+    }
+#endif
+
     if (arg6 >= 0)
     {
         kcb->flag = arg6;
@@ -219,6 +331,9 @@ int font_get_buffer_size(KCB *kcb)
 
 void font_set_buffer(KCB *kcb, void *buffer)
 {
+#ifdef DEV_EXE
+    font_forget_print(buffer);
+#endif
     kcb->font_clut_buffer = buffer;
     kcb->font_buffer = buffer + 0x20;
 }
@@ -280,6 +395,123 @@ static unsigned int font_get_glyph_config(int a1)
     return LLOAD(&gFontBegin[4 * a1]);
 }
 
+#ifdef DEV_EXE
+static void font_init_glyph_rows(void)
+{
+    unsigned int fill, bits;
+    u_char       odd[3];
+    char         palette;
+    char         glyph;
+    char         pixels;
+    int          p, b, i, k, shift;
+
+    for (p = 0; p < 4; p++)
+    {
+        // the types of font_draw_glyph's locals, for the same sign extension
+        palette = p;
+        fill = (palette << 6) | (palette << 2);
+
+        for (b = 0; b < 256; b++)
+        {
+            glyph = b;
+
+            font_glyph_even[p][b] =
+                (u_char)(fill | ((glyph >> 6) | (glyph & 0x30))) |
+                ((u_char)(fill | (((glyph & 0xC) >> 2) | ((glyph & 3) * 16))) << 8);
+
+            // at an odd x, the four pixels of a byte land in three bytes
+            odd[0] = odd[1] = odd[2] = 0;
+            pixels = glyph;
+            shift = 4;
+            k = 0;
+
+            for (i = 0; i < 4; i++)
+            {
+                bits = pixels;
+                bits >>= 6;
+                odd[k] |= (((p << 2) | bits) & 0xFF) << shift;
+                pixels <<= 2;
+
+                if (shift == 4)
+                {
+                    shift = 0;
+                    k++;
+                }
+                else
+                {
+                    shift = 4;
+                }
+            }
+
+            font_glyph_odd[p][b] = odd[0] | (odd[1] << 8) | (odd[2] << 16);
+        }
+    }
+
+    font_glyph_ready = 1;
+}
+
+static void font_draw_glyph_rows(char *buffer, int width, u_char *glyph, int odd)
+{
+    u_short *even_row;
+    u_long  *odd_row;
+    u_long   bits;
+    int      i;
+
+    if (!font_glyph_ready)
+    {
+        font_init_glyph_rows();
+    }
+
+    if (!odd)
+    {
+        even_row = font_glyph_even[font_palette_800AB6BC];
+
+        for (i = 12; i > 0; i--)
+        {
+            bits = even_row[glyph[0]];
+            buffer[0] = bits;
+            buffer[1] = bits >> 8;
+
+            bits = even_row[glyph[1]];
+            buffer[2] = bits;
+            buffer[3] = bits >> 8;
+
+            bits = even_row[glyph[2]];
+            buffer[4] = bits;
+            buffer[5] = bits >> 8;
+
+            glyph += 3;
+            buffer += width;
+        }
+
+        return;
+    }
+
+    odd_row = font_glyph_odd[font_palette_800AB6BC];
+
+    for (i = 12; i > 0; i--)
+    {
+        bits = odd_row[glyph[0]];
+        buffer[0] |= bits;
+        buffer[1] |= bits >> 8;
+        buffer[2] |= bits >> 16;
+
+        bits = odd_row[glyph[1]];
+        buffer[2] |= bits;
+        buffer[3] |= bits >> 8;
+        buffer[4] |= bits >> 16;
+
+        bits = odd_row[glyph[2]];
+        buffer[4] |= bits;
+        buffer[5] |= bits >> 8;
+        buffer[6] |= bits >> 16;
+
+        glyph += 3;
+        buffer += width;
+    }
+}
+#endif
+
 static void font_draw_glyph(char *buffer, int x, int y, int width, char *glyph)
 {
     unsigned int i;
@@ -323,6 +555,14 @@ static void font_draw_glyph(char *buffer, int x, int y, int width, char *glyph)
     var_a1 = glyph;
     buffer = buffer + (x / 2) + ((++y) * width);
 
+#ifdef DEV_EXE
+    if (font_glyph_cache && var_a1 && x >= 0 && (unsigned int)font_palette_800AB6BC < 4)
+    {
+        font_draw_glyph_rows(buffer, width, (u_char *)var_a1, x & 1);
+        return;
+    }
+#endif
+
     if (!(x & 1))
     {
         if (var_a1 == NULL)
@@ -973,6 +1213,10 @@ long font_draw_string(KCB *kcb, long xtop, long ytop, const char *string, long c
         return 0;
     }
 
+#ifdef DEV_EXE
+    font_forget_print(kcb->font_buffer);
+#endif
+
     counter1 = 0;
     dword_800AB6B8 = 0;
     xmax = kcb->short1;
@@ -1399,6 +1643,10 @@ void font_clear(KCB *kcb)
     int *font_buffer;
     int  i;
 
+#ifdef DEV_EXE
+    font_forget_print(kcb->font_buffer);
+#endif
+
     if (!(kcb->flag & 0x10))
     {
         font_buffer = kcb->font_buffer;
@@ -1413,7 +1661,16 @@ void font_clear(KCB *kcb)
 
 void font_update(KCB *kcb)
 {
+#ifdef DEV_EXE
+    long intime;
+
+    intime = GetRCnt(RCntCNT1);
+    LoadImage(&kcb->font_rect, kcb->font_buffer);
+    font_blit_hsyncs += (GetRCnt(RCntCNT1) - intime) & 0xffff;
+    font_blit_count++;
+#else
     LoadImage(&kcb->font_rect, kcb->font_buffer);
+#endif
 }
 
 void font_clut_update(KCB *kcb)
@@ -1421,8 +1678,257 @@ void font_clut_update(KCB *kcb)
     LoadImage(&kcb->font_clut_rect, kcb->font_clut_buffer);
 }
 
+#ifdef DEV_EXE
+static unsigned long font_string_sum(const char *string)
+{
+    unsigned long sum;
+
+    for (sum = 0; *string; string++)
+    {
+        sum = sum * 31 + (u_char)*string;
+    }
+
+    return sum;
+}
+
+static int font_same_print(FONT_PRINT *print, KCB *kcb, const char *string, unsigned long sum)
+{
+    return print->string == string && print->sum == sum && print->color == kcb->color &&
+           print->ytop == kcb->ytop && print->rubi == rubi_display_flag &&
+           print->option == (GM_OptionFlag & OPTION_BUTTON_MASK);
+}
+
+static void font_set_print(FONT_PRINT *print, KCB *kcb, const char *string, unsigned long sum)
+{
+    print->string = string;
+    print->sum = sum;
+    print->color = kcb->color;
+    print->ytop = kcb->ytop;
+    print->rubi = rubi_display_flag;
+    print->option = GM_OptionFlag & OPTION_BUTTON_MASK;
+    print->max_width = kcb->max_width;
+    print->short3 = kcb->short3;
+}
+
+static FONT_PRINT *font_find_print(KCB *kcb, const char *string, unsigned long sum)
+{
+    FONT_PRINT *print;
+    int         i;
+
+    print = font_print;
+    for (i = FONT_PRINT_ENTRIES; i > 0; i--, print++)
+    {
+        if (print->buffer == kcb->font_buffer && font_same_print(print, kcb, string, sum))
+        {
+            return print;
+        }
+    }
+
+    return NULL;
+}
+
+static void font_store_print(KCB *kcb, const char *string, unsigned long sum)
+{
+    FONT_PRINT *print;
+
+    // a string that ends inside a rubi or title block leaves state behind
+    if (r_flag_800AB6C0 || rubi_flag_800AB6C4)
+    {
+        return;
+    }
+
+    print = &font_print[font_print_next];
+    font_print_next = (font_print_next + 1) % FONT_PRINT_ENTRIES;
+
+    print->buffer = kcb->font_buffer;
+    font_set_print(print, kcb, string, sum);
+}
+
+static FONT_PRINT *font_find_line(KCB *kcb, const char *string, unsigned long sum)
+{
+    FONT_PRINT *line;
+    int         i;
+
+    line = font_line;
+    for (i = font_line_count; i > 0; i--, line++)
+    {
+        if (line->buffer && font_same_print(line, kcb, string, sum))
+        {
+            return line;
+        }
+    }
+
+    return NULL;
+}
+
+/* Draws a line into the store, leaving the kcb and the rubi state as they were */
+static FONT_PRINT *font_draw_line(KCB *kcb, const char *string, unsigned long sum)
+{
+    KCB         line_kcb;
+    FONT_PRINT *line;
+    int         r_flag, rubi_flag;
+    int         rubi_x, rubi_y, rubi_xmax;
+    long        intime;
+
+    line = &font_line[font_line_next];
+    font_line_next = (font_line_next + 1) % font_line_count;
+
+    r_flag = r_flag_800AB6C0;
+    rubi_flag = rubi_flag_800AB6C4;
+    rubi_x = rubi_left_pos_x_800ABB2C;
+    rubi_y = rubi_left_pos_y_800ABB30;
+    rubi_xmax = rubi_left_pos_xmax_800ABB34;
+
+    line_kcb = *kcb;
+    line_kcb.font_buffer = font_line_store + (line - font_line) * font_line_size;
+    line_kcb.flag &= ~0x10;
+
+    intime = GetRCnt(RCntCNT1);
+    font_clear(&line_kcb);
+    font_draw_string(&line_kcb, 0, line_kcb.ytop, string, line_kcb.color);
+    font_layout_hsyncs += (GetRCnt(RCntCNT1) - intime) & 0xffff;
+    font_layout_count++;
+
+    line->buffer = line_kcb.font_buffer;
+    font_set_print(line, &line_kcb, string, sum);
+
+    if (r_flag_800AB6C0 || rubi_flag_800AB6C4)
+    {
+        line->buffer = NULL;
+        line = NULL;
+    }
+
+    r_flag_800AB6C0 = r_flag;
+    rubi_flag_800AB6C4 = rubi_flag;
+    rubi_left_pos_x_800ABB2C = rubi_x;
+    rubi_left_pos_y_800ABB30 = rubi_y;
+    rubi_left_pos_xmax_800ABB34 = rubi_xmax;
+
+    return line;
+}
+
+/* 'store' holds 'count' lines of font_get_buffer_size bytes, or is NULL to drop it */
+void font_keep_lines(KCB *kcb, void *store, int count)
+{
+    int i;
+
+    if (count > FONT_LINE_ENTRIES)
+    {
+        count = FONT_LINE_ENTRIES;
+    }
+
+    for (i = 0; i < FONT_LINE_ENTRIES; i++)
+    {
+        font_line[i].buffer = NULL;
+    }
+
+    font_line_owner = (store && count > 0) ? kcb->font_buffer : NULL;
+    font_line_store = store;
+    font_line_size = kcb->width_info * kcb->height_info;
+    font_line_count = count;
+    font_line_next = 0;
+}
+
+/* Draws a line into the store of the kcb, so printing it later only copies it */
+void font_layout_string(KCB *kcb, const char *string)
+{
+    unsigned long sum;
+
+    if (!font_print_cache || !dword_800ABB28 || !font_line_owner ||
+        kcb->font_buffer != font_line_owner)
+    {
+        return;
+    }
+
+    sum = font_string_sum(string);
+    if (!font_find_line(kcb, string, sum))
+    {
+        font_draw_line(kcb, string, sum);
+    }
+}
+
+/* Remembers a buffer the caller has drawn, until it is cleared or drawn into */
+void font_keep_buffer(void *buffer)
+{
+    font_kept_buffer = buffer;
+}
+
+int font_buffer_kept(void *buffer)
+{
+    return buffer && buffer == font_kept_buffer;
+}
+
+void font_print_stats(const char *name)
+{
+    printf("font %s: %d layouts %d hsync, %d blits %d hsync queued, %d prints kept, %d lines copied\n",
+           name, font_layout_count, font_layout_hsyncs, font_blit_count, font_blit_hsyncs,
+           font_print_hits, font_line_hits);
+
+    font_layout_count = 0;
+    font_layout_hsyncs = 0;
+    font_blit_count = 0;
+    font_blit_hsyncs = 0;
+    font_print_hits = 0;
+    font_print_misses = 0;
+    font_line_hits = 0;
+}
+#endif
+
 void font_print_string(KCB *kcb, const char *string)
 {
+#ifdef DEV_EXE
+    FONT_PRINT   *print;
+    FONT_PRINT   *line;
+    unsigned long sum;
+    long          intime;
+
+    if (font_print_cache && dword_800ABB28)
+    {
+        sum = font_string_sum(string);
+        print = font_find_print(kcb, string, sum);
+        if (print)
+        {
+            kcb->max_width = print->max_width;
+            kcb->short3 = print->short3;
+            font_print_hits++;
+            return;
+        }
+
+        font_print_misses++;
+
+        line = NULL;
+        if (font_line_owner && kcb->font_buffer == font_line_owner)
+        {
+            line = font_find_line(kcb, string, sum);
+            if (!line)
+            {
+                line = font_draw_line(kcb, string, sum);
+            }
+        }
+
+        if (line)
+        {
+            font_forget_print(kcb->font_buffer);
+            GV_CopyMemory(line->buffer, kcb->font_buffer, font_line_size);
+            kcb->flag &= ~0x10;
+            kcb->max_width = line->max_width;
+            kcb->short3 = line->short3;
+            font_line_hits++;
+        }
+        else
+        {
+            intime = GetRCnt(RCntCNT1);
+            font_clear(kcb);
+            font_draw_string(kcb, 0, kcb->ytop, string, kcb->color);
+            font_layout_hsyncs += (GetRCnt(RCntCNT1) - intime) & 0xffff;
+            font_layout_count++;
+        }
+
+        font_store_print(kcb, string, sum);
+        return;
+    }
+#endif
+
     font_clear(kcb);
     font_draw_string(kcb, 0, kcb->ytop, string, kcb->color);
 }
@@ -58,4 +58,27 @@ void  font_update(KCB *kcb);
 void  font_clut_update(KCB *kcb);
 void  font_print_string(KCB *kcb, const char *string);
 
+#ifdef DEV_EXE
+extern int font_glyph_cache;
+extern int font_print_cache;
+extern int font_print_hits;
+extern int font_print_misses;
+extern int font_line_hits;
+extern int font_layout_count;
+extern int font_layout_hsyncs;
+extern int font_blit_count;
+extern int font_blit_hsyncs;
+
+void  font_keep_lines(KCB *kcb, void *store, int count);
+void  font_layout_string(KCB *kcb, const char *string);
+void  font_keep_buffer(void *buffer);
+int   font_buffer_kept(void *buffer);
+void  font_print_stats(const char *name);
+
+/* contrib/dev/font_bench.c */
+extern int font_bench_request;
+
+void  font_bench_radio(unsigned char *block);
+#endif
+
 #endif // __MGS_FONT_H__
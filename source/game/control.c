@@ -16,23 +16,65 @@
 int SECTION(".sbss") GM_CurrentMap;
 int SECTION(".sbss") gControlCount_800AB9B4;
 
-extern CONTROL *GM_WhereList[96];
+extern CONTROL *GM_WhereList[MAX_CONTROLS];
 extern CONTROL  gDefaultControl_800B5650;
 
+#ifdef DEV_EXE
+/*
+ * Where list index (dev only). GM_WhereFind looks a control up by name
+ * through hash chains, and GM_WhereInBox lists the controls in an XZ box
+ * through a grid of WHERE_CELL sized cells over the whole short range.
+ * Both return what a scan of GM_WhereList would, in list order.
+ *
+ * Controls move by writing mov directly, so the index is built by the
+ * first query of each game frame (and again after the list changes) and
+ * boxes are widened by WHERE_SLACK for movement later in the frame. A
+ * control moved further than that since the build, in the same frame,
+ * isn't found; GM_WhereGrid = 0 sends the queries back to the scan.
+ */
+#define WHERE_CELL_SHIFT    12
+#define WHERE_CELLS         (0x10000 >> WHERE_CELL_SHIFT)  /* per axis */
+#define WHERE_NAMES         64
+#define WHERE_SLACK         512
+
+int GM_WhereGrid = 1;
+
+STATIC short    where_cell_first[WHERE_CELLS * WHERE_CELLS];
+STATIC short    where_cell_next[MAX_CONTROLS];
+STATIC short    where_name_first[WHERE_NAMES];
+STATIC short    where_name_next[MAX_CONTROLS];
+STATIC CONTROL *where_found[MAX_CONTROLS];
+STATIC short    where_found_at[MAX_CONTROLS];  // list index of each where_found entry
+STATIC int      where_time = -1;   // GV_Time of the build, -1 once the list changed
+#endif
+
 /* static? */
 int GM_ControlPushBack(CONTROL *control)
 {
     // スネーク must always be the first item
+#ifdef DEV_EXE
+    where_time = -1;
+#endif
+
     if (control->name == CHARAID_SNAKE)
     {
         GM_WhereList[0] = control;
+#ifdef DEV_EXE
+        control->where = 0;
+#endif
     }
     else
     {
         if (gControlCount_800AB9B4 > MAX_CONTROLS - 1)
         {
+#ifdef DEV_EXE
+            printf("ControlPushBack : where list full, %X dropped\n", control->name);
+#endif
             return -1;
         }
+#ifdef DEV_EXE
+        control->where = gControlCount_800AB9B4;
+#endif
         GM_WhereList[gControlCount_800AB9B4] = control;
         gControlCount_800AB9B4++;
     }
@@ -48,6 +90,22 @@ void GM_ControlRemove(CONTROL *control)
 
     CONTROL **pControlIter = GM_WhereList;
 
+#ifdef DEV_EXE
+    where_time = -1;
+
+    // swap the last entry into the stored index, no search needed
+    i = control->where;
+    if (i > 0 && i < totalCount && GM_WhereList[i] == control)
+    {
+        GM_WhereList[i] = GM_WhereList[--totalCount];
+        GM_WhereList[i]->where = i;
+        gControlCount_800AB9B4 = totalCount;
+        return;
+    }
+
+    i = totalCount;
+#endif
+
     while (i > 0)
     {
         i--;
@@ -67,6 +125,9 @@ found:
     {
         *pControlIter = GM_WhereList[--totalCount];
         gControlCount_800AB9B4 = totalCount;
+#ifdef DEV_EXE
+        (*pControlIter)->where = pControlIter - GM_WhereList;
+#endif
     }
     else
     {
@@ -78,7 +139,153 @@ void GM_InitWhereSystem(void)
 {
     GM_WhereList[0] = &gDefaultControl_800B5650;
     gControlCount_800AB9B4 = 1;
+#ifdef DEV_EXE
+    where_time = -1;
+#endif
+}
+
+#ifdef DEV_EXE
+static inline int WhereCell(int pos)
+{
+    return (pos + 0x8000) >> WHERE_CELL_SHIFT;
+}
+
+static inline int WhereClampCell(int pos)
+{
+    if (pos < -0x8000)
+    {
+        pos = -0x8000;
+    }
+    else if (pos > 0x7FFF)
+    {
+        pos = 0x7FFF;
+    }
+
+    return WhereCell(pos);
+}
+
+/* Chains are built from the end of the list, so each one is in list order */
+static void WhereBuild(void)
+{
+    CONTROL *control;
+    int      cell;
+    int      i;
+
+    for (i = 0; i < WHERE_CELLS * WHERE_CELLS; i++)
+    {
+        where_cell_first[i] = -1;
+    }
+
+    for (i = 0; i < WHERE_NAMES; i++)
+    {
+        where_name_first[i] = -1;
+    }
+
+    for (i = gControlCount_800AB9B4 - 1; i >= 0; i--)
+    {
+        control = GM_WhereList[i];
+
+        cell = WhereCell(control->mov.vz) * WHERE_CELLS + WhereCell(control->mov.vx);
+        where_cell_next[i] = where_cell_first[cell];
+        where_cell_first[cell] = i;
+
+        where_name_next[i] = where_name_first[control->name % WHERE_NAMES];
+        where_name_first[control->name % WHERE_NAMES] = i;
+    }
+
+    where_time = GV_Time;
+}
+
+/* Returns the first control in the where list with this name, or NULL */
+CONTROL *GM_WhereFind(int name)
+{
+    int i;
+
+    if (!GM_WhereGrid)
+    {
+        for (i = 0; i < gControlCount_800AB9B4; i++)
+        {
+            if (GM_WhereList[i]->name == name)
+            {
+                return GM_WhereList[i];
+            }
+        }
+
+        return NULL;
+    }
+
+    if (where_time != GV_Time)
+    {
+        WhereBuild();
+    }
+
+    for (i = where_name_first[(u_short)name % WHERE_NAMES]; i >= 0; i = where_name_next[i])
+    {
+        if (GM_WhereList[i]->name == name)
+        {
+            return GM_WhereList[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Lists the controls whose XZ position may be inside min..max, in where
+ * list order, and returns how many. The list is only valid until the next
+ * query, and the caller still checks each position.
+ */
+int GM_WhereInBox(SVECTOR *min, SVECTOR *max, CONTROL ***list)
+{
+    int      x0, x1, z0, z1;
+    int      x, z;
+    int      count;
+    int      i, j;
+
+    *list = where_found;
+
+    if (!GM_WhereGrid)
+    {
+        for (i = 0; i < gControlCount_800AB9B4; i++)
+        {
+            where_found[i] = GM_WhereList[i];
+        }
+
+        return gControlCount_800AB9B4;
+    }
+
+    if (where_time != GV_Time)
+    {
+        WhereBuild();
+    }
+
+    x0 = WhereClampCell(min->vx - WHERE_SLACK);
+    x1 = WhereClampCell(max->vx + WHERE_SLACK);
+    z0 = WhereClampCell(min->vz - WHERE_SLACK);
+    z1 = WhereClampCell(max->vz + WHERE_SLACK);
+
+    count = 0;
+    for (z = z0; z <= z1; z++)
+    {
+        for (x = x0; x <= x1; x++)
+        {
+            for (i = where_cell_first[z * WHERE_CELLS + x]; i >= 0; i = where_cell_next[i])
+            {
+                // insert by list index, the cells come in any order
+                for (j = count++; j > 0 && where_found_at[j - 1] > i; j--)
+                {
+                    where_found[j] = where_found[j - 1];
+                    where_found_at[j] = where_found_at[j - 1];
+                }
+                where_found[j] = GM_WhereList[i];
+                where_found_at[j] = i;
+            }
+        }
+    }
+
+    return count;
 }
+#endif
 
 int GM_InitControl(CONTROL *control, int scriptData, int scriptBinds)
 {
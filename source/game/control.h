@@ -61,9 +61,17 @@ typedef struct CONTROL
     SVECTOR     nearvecs[2];
     void       *nears[2];  // HZD_SEG when tagged, HZD_FLR when untagged
     short       levels[2]; // floor and ceiling heights
+#ifdef DEV_EXE
+    short       where;     // index in GM_WhereList while registered
+    short       pad;
+#endif
 } CONTROL;
 
+#ifdef DEV_EXE
+#define MAX_CONTROLS 256
+#else
 #define MAX_CONTROLS 96
+#endif
 
 /* control.c */
 // int  GM_ControlPushBack(CONTROL *control);
@@ -83,4 +91,11 @@ int  GM_CheckControlTouches(CONTROL *control, int param_2);
 void GM_ConfigControlTrapCheck(CONTROL *control);
 GV_MSG *GM_CheckMessage(GV_ACT *actor, int msgType, int toFind);
 
+#ifdef DEV_EXE
+extern int GM_WhereGrid;
+
+CONTROL *GM_WhereFind(int name);
+int      GM_WhereInBox(SVECTOR *min, SVECTOR *max, CONTROL ***list);
+#endif
+
 #endif // __MGS_GAME_CONTROL_H__
@@ -415,6 +415,10 @@ static void Act(gameWork *work)
             GCL_SaveVar();
         }
 
+#ifdef DEV_EXE
+        GV_PadRecStageStart();
+        GCL_SnapStageStart();
+#endif
         printf("exec scenario\n");
         load_request = GM_LoadRequest;
         GM_LoadRequest = 0;
@@ -437,6 +441,15 @@ static void Act(gameWork *work)
         return;
     }
 
+#ifdef DEV_EXE
+    GCL_SnapFrame();
+
+    if (stream_bench_request)
+    {
+        FS_StreamBench();
+    }
+#endif
+
     if ((work->killing_count <= 0))
     {
         if (GM_GameOverTimer != 0)
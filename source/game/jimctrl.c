@@ -303,6 +303,20 @@ static void Act(JimakuCtrlWork *work)
             work->field_40 = 0;
 
             font_set_font_addr(3, (char *)pHeader + pHeader2->font_offset);
+
+#ifdef DEV_EXE
+            // lay out the packet's first subtitles now rather than as they show
+            if (work->field_24 != 1)
+            {
+                int i;
+
+                for (i = 0; pSubtitles && i < MENU_JIMAKU_LINES; i++)
+                {
+                    MENU_JimakuLayout((char *)(pSubtitles + 4));
+                    pSubtitles = pSubtitles[0] ? (int *)((char *)pSubtitles + pSubtitles[0]) : NULL;
+                }
+            }
+#endif
         }
 
         work->field_20 = 1;
@@ -344,6 +358,9 @@ static void Die(JimakuCtrlWork *work)
     jimctrl_kill_helper_clear_80038004(work);
     dword_8009E28C = NULL;
     FS_StreamClose();
+#ifdef DEV_EXE
+    font_print_stats("jimaku");
+#endif
 }
 
 void *NewJimakuControl(u_long flags)
@@ -19,6 +19,15 @@
 
 #define BODY_FLAG ( DG_FLAG_SHADE | DG_FLAG_TRANS | DG_FLAG_TEXT )
 
+#ifdef DEV_EXE
+/* A seeked demo runs its records more than once (contrib/dev/demo_seek.c),
+ * so offsets that are already pointers are left alone */
+#define DEMO_OFFSET_TO_PTR(ptr, offset) \
+    ((*(int *)(offset) >= 0) ? OFFSET_TO_PTR(ptr, offset) : 0)
+#else
+#define DEMO_OFFSET_TO_PTR(ptr, offset) OFFSET_TO_PTR(ptr, offset)
+#endif
+
 extern UnkCameraStruct2 gUnkCameraStruct2_800B7868;
 extern BLAST_DATA       blast_data_8009F4B8[8];
 extern GM_CAMERA        GM_Camera;
@@ -375,8 +384,8 @@ int FrameRunDemo(DemoWork *work, DMO_DAT *data)
     ACTNODE  *iter;
     DMO_ADJ  *adjust;
 
-    OFFSET_TO_PTR(data, &data->chara);
-    OFFSET_TO_PTR(data, &data->adjust);
+    DEMO_OFFSET_TO_PTR(data, &data->chara);
+    DEMO_OFFSET_TO_PTR(data, &data->adjust);
 
     work->control.mov.vx = data->eye_x;
     work->control.mov.vy = data->eye_y;
@@ -2072,7 +2081,7 @@ static int demothrd_8007CFE8(DemoWork *work, DMO_ADJ *adjust)
     int         i;
     short      *rots;
 
-    OFFSET_TO_PTR(adjust, &adjust->rots);
+    DEMO_OFFSET_TO_PTR(adjust, &adjust->rots);
 
     model_file = work->header->models;
     model = work->models;
@@ -3536,6 +3545,14 @@ void DemoScreenObjs(DG_OBJS *pObjs)
 
     *(MATRIX *)getScratchAddr(8) = pObjs->world;
 
+#ifdef DEV_EXE
+    // the camera translation is at scrpad->translation, see DemoScreenChanl
+    if (DG_PoseUnchanged(pObjs, 1, (long *)getScratchAddr(0xE0)))
+    {
+        return;
+    }
+#endif
+
     if (pObjs->flag & DG_FLAG_ONEPIECE)
     {
         DemoScreenModelsSingle(pObjs, n_models);
@@ -3579,8 +3596,16 @@ void DemoScreenChanl(DG_CHANL *chanl, int idx)
 
     DG_AdjustOverscan(&scrpad->matrix);
 
+#ifdef DEV_EXE
+    DG_PoseBenchStart();
+#endif
+
     for (count = chanl->mTotalObjectCount; count > 0; count--)
     {
         DemoScreenObjs(*ppObjs++);
     }
+
+#ifdef DEV_EXE
+    DG_PoseBenchEnd();
+#endif
 }
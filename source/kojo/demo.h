@@ -570,4 +570,15 @@ typedef struct DMO_DATA_0x36
 int DM_ThreadStream(int flag, int unused);
 int DM_ThreadFile(int flag, char *filename);
 
+#ifdef DEV_EXE
+/* contrib/dev/demo_seek.c */
+extern int demo_seek_frame;
+extern int demo_seek_pause;
+extern int demo_bench;
+
+void DM_SeekStart(DemoWork *work);
+void DM_SeekUpdate(DemoWork *work, int time);
+void DM_SeekEnd(void);
+#endif
+
 #endif // __MGS_KOJO_DEMO_H__
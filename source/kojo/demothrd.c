@@ -211,6 +211,12 @@ static void FileAct(DemoWork *work)
             printf("Error:Initialize demo\n");
             GV_DestroyActor(&work->actor);
         }
+#ifdef DEV_EXE
+        else
+        {
+            DM_SeekStart(work);
+        }
+#endif
 
         work->frame = 0;
         return;
@@ -233,6 +239,10 @@ static void FileAct(DemoWork *work)
 
     work->frame = new_time;
 
+#ifdef DEV_EXE
+    DM_SeekUpdate(work, time);
+#endif
+
     if (work->header->n_frames < work->frame)
     {
         success = 0;
@@ -262,6 +272,9 @@ static void FileDie(DemoWork *work)
 {
     DestroyDemo(work);
     FS_EnableMemfile(1, 1);
+#ifdef DEV_EXE
+    DM_SeekEnd();
+#endif
 
     if (demodebug_finish_proc != -1)
     {
@@ -22,6 +22,36 @@ STATIC void DG_SubDivideRVectors( void );
 STATIC void DG_InitRVector( DG_OBJ *obj,  int idx );
 STATIC void DG_AddSubdividedPrim( DG_OBJ *obj, int idx );
 
+#ifdef DEV_EXE
+/*
+ * Subdivided packets come from a per-buffer arena first, and only spill
+ * into the free units of the packet heap (the original source) once the
+ * arena is used up. The arena is only storage: n_packs is still the number
+ * of packets the heap's free units hold, so the amount of subdivision is
+ * the same as without the arena.
+ *
+ * The arena is static, since nothing can be allocated for it per frame, so
+ * it can't grow with DG_DivideHighWater. DIVIDE_ARENA_PACKS is its capacity
+ * and DG_DivideArenaPacks the part of it in use.
+ *
+ * With DG_DivideAdaptive set, the area above which a polygon is split
+ * again (0x800) is doubled after a frame that spilled out of the arena and
+ * halved back after a frame that used less than half of it.
+ */
+#define DIVIDE_ARENA_PACKS  384
+#define DIVIDE_MIN_AREA     0x800
+#define DIVIDE_MAX_AREA     0x8000
+
+int DG_DivideArenaPacks = DIVIDE_ARENA_PACKS;   // 0 disables the arena
+int DG_DivideAdaptive = 0;
+int DG_DivideOverflows;                         // frames that spilled to the heap
+int DG_DivideHighWater;                         // most packets used in a frame
+
+STATIC POLY_GT4 divide_arena[2][DIVIDE_ARENA_PACKS];
+STATIC int      divide_total;
+STATIC int      divide_area = DIVIDE_MIN_AREA;
+#endif
+
 STATIC void *DG_SplitMemory( int memIdx, int *n_split, int size )
 {
     int i, split_count;
@@ -60,6 +90,24 @@ STATIC POLY_GT4 *DG_InitDividePacks( int memIdx )
     divide_mem->pAlloc = 0;
     pack = DG_AllocDividePackMem( heap, &divide_mem->pAlloc, &divide_mem->size );
 
+#ifdef DEV_EXE
+    // a heap without free units still draws nothing, as without the arena
+    if ( pack && DG_DivideArenaPacks > 0 )
+    {
+        if ( DG_DivideArenaPacks > DIVIDE_ARENA_PACKS )
+        {
+            DG_DivideArenaPacks = DIVIDE_ARENA_PACKS;
+        }
+
+        // DG_GetDividePacks moves on to the heap's free units when this runs out
+        divide_mem->pAlloc = 0;
+        pack = divide_arena[ memIdx & 1 ];
+        divide_mem->size = DG_DivideArenaPacks * 0x34;
+    }
+
+    divide_total = divide_mem->n_packs;
+#endif
+
     divide_mem->pDataStart = pack;
     return pack;
 }
@@ -542,6 +590,44 @@ STATIC void DG_AddSubdividedPrim( DG_OBJ *obj, int idx )
     }
 }
 
+#ifdef DEV_EXE
+STATIC void DG_DivideAccount( void )
+{
+    DG_DivideMem *divide_mem;
+    int           used;
+
+    divide_mem = GetDivideMem();
+    used = divide_total - divide_mem->n_packs;
+
+    if ( used > DG_DivideHighWater )
+    {
+        DG_DivideHighWater = used;
+    }
+
+    if ( DG_DivideArenaPacks <= 0 )
+    {
+        return;
+    }
+
+    // pAlloc is only set once the arena ran out and a packet came from the
+    // heap. n_packs running out on its own is the heap's budget, the same
+    // as without the arena, and doesn't count
+    if ( divide_mem->pAlloc )
+    {
+        DG_DivideOverflows++;
+
+        if ( divide_area < DIVIDE_MAX_AREA )
+        {
+            divide_area *= 2;
+        }
+    }
+    else if ( used < DG_DivideArenaPacks / 2 && divide_area > DIVIDE_MIN_AREA )
+    {
+        divide_area /= 2;
+    }
+}
+#endif
+
 void DG_DivideChanl( DG_CHANL *chanl, int idx )
 {
     int i, j, x;
@@ -556,7 +642,11 @@ void DG_DivideChanl( DG_CHANL *chanl, int idx )
 
     divide_mem = GetDivideMem();
     divide_mem->ot = (long *)ptr_800B1400;
+#ifdef DEV_EXE
+    divide_mem->field_14 = DG_DivideAdaptive ? divide_area : DIVIDE_MIN_AREA;
+#else
     divide_mem->field_14 = 0x800;
+#endif
 
     if ( chanl->clip_distance > 1000)
     {
@@ -616,6 +706,10 @@ void DG_DivideChanl( DG_CHANL *chanl, int idx )
             }
         }
     }
+
+#ifdef DEV_EXE
+    DG_DivideAccount();
+#endif
 }
 
 void DG_DivideEnd( void )
@@ -508,6 +508,13 @@ void DG_DivideStart( void );
 void DG_DivideChanl( DG_CHANL *chanl, int idx );
 void DG_DivideEnd( void );
 
+#ifdef DEV_EXE
+extern int DG_DivideArenaPacks;
+extern int DG_DivideAdaptive;
+extern int DG_DivideOverflows;
+extern int DG_DivideHighWater;
+#endif
+
 /* light.c */
 extern MATRIX DG_LightMatrix;
 extern MATRIX DG_ColorMatrix;
@@ -597,6 +604,25 @@ int  DG_PointCheckOne( DVECTOR *line );
 // void DG_ApplyMovs( DG_OBJS *objs, int n_obj );
 // void DG_ApplyRots( DG_OBJS *objs, int n_obj );
 void DG_ScreenChanl( DG_CHANL *chanl, int idx );
+#ifdef DEV_EXE
+enum {
+    DG_POSE_STAT_COMPOSED,      // objects screened
+    DG_POSE_STAT_KEPT,          // objects whose matrices were kept
+    DG_POSE_STAT_UNCACHED,      // objects the cache can't hold
+    DG_POSE_STAT_JOINTS,        // models screened
+    DG_POSE_STAT_JOINTS_KEPT,   // models whose matrices were kept
+    DG_POSE_STAT_MAX
+};
+
+extern int DG_PoseCache;
+extern int DG_PoseBench;
+extern int DG_PoseStats[DG_POSE_STAT_MAX];
+
+int  DG_PoseUnchanged( DG_OBJS *objs, int kind, long *eye_t );
+void DG_PoseForget( DG_OBJS *objs );
+void DG_PoseBenchStart( void );
+void DG_PoseBenchEnd( void );
+#endif
 
 /* shade.c */
 void DG_ShadeStart( void );
@@ -91,6 +91,9 @@ void DG_FreeObjs( DG_OBJS *objs )
         ++obj;
     }
     DG_FreePreshade(objs);
+#ifdef DEV_EXE
+    DG_PoseForget(objs);
+#endif
     GV_Free(objs);
 }
 
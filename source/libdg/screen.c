@@ -5,6 +5,10 @@
 #include <libgte.h>
 #include <libgpu.h>
 #include "common.h"
+#ifdef DEV_EXE
+#include <stdio.h>
+#include <libapi.h>
+#endif
 
 extern DG_CHANL DG_Chanls[3];
 
@@ -192,6 +196,234 @@ int DG_PointCheckOne( DVECTOR *line )
     return first_points.vy + 0x98 < MAX_Y;
 }
 
+#ifdef DEV_EXE
+#define DG_POSE_SLOTS       48
+#define DG_POSE_JOINTS      24
+#define DG_POSE_BENCH_CALLS 300
+
+#define DG_POSE_ROTS        0x1
+#define DG_POSE_MOVS        0x2
+#define DG_POSE_ADJUST      0x4
+#define DG_POSE_WAIST       0x8
+
+/* The inputs an object was last screened from. The world and screen matrices
+ * of its models only depend on these, so while they stay the same the
+ * matrices left in the DG_OBJ from the last frame are still right */
+typedef struct DG_POSE
+{
+    DG_OBJS *objs;
+    DG_DEF  *def;
+    int      kind;
+    int      inputs;
+    int      n_models;
+    MATRIX   eye;
+    long     eye_t[3];
+    MATRIX   world;
+    SVECTOR  waist_rot;
+    SVECTOR  joints[DG_POSE_JOINTS];
+    SVECTOR  adjust[DG_POSE_JOINTS];
+} DG_POSE;
+
+int DG_PoseCache = 1;
+int DG_PoseBench;
+int DG_PoseStats[DG_POSE_STAT_MAX];
+
+STATIC DG_POSE dg_pose_slots[DG_POSE_SLOTS];
+STATIC long    dg_pose_intime;
+STATIC int     dg_pose_hsyncs;
+STATIC int     dg_pose_calls;
+STATIC int     dg_pose_bench_on;
+
+/* Copies input to cache, returns 1 if they were already the same */
+static int dg_pose_sync( u_long *cache, u_long *input, int words )
+{
+    int same;
+
+    same = 1;
+    for ( ; words > 0; words--, cache++, input++ )
+    {
+        if ( *cache != *input )
+        {
+            *cache = *input;
+            same = 0;
+        }
+    }
+
+    return same;
+}
+
+/* Returns 1 if objs can keep the matrices from its last screen pass. 'kind'
+ * tells the screen functions apart, and eye_t is the camera translation
+ * kept outside the view matrix (DemoScreenChanl), if any. */
+int DG_PoseUnchanged( DG_OBJS *objs, int kind, long *eye_t )
+{
+    DG_POSE *pose;
+    int      n_models;
+    int      inputs;
+    int      same;
+
+    n_models = objs->n_models;
+    inputs = 0;
+
+    if ( !( objs->flag & DG_FLAG_ONEPIECE ) )
+    {
+        if ( objs->rots )
+        {
+            inputs = DG_POSE_ROTS;
+            if ( objs->adjust ) inputs |= DG_POSE_ADJUST;
+            if ( objs->waist_rot ) inputs |= DG_POSE_WAIST;
+        }
+        else if ( objs->movs )
+        {
+            inputs = DG_POSE_MOVS;
+        }
+    }
+
+    // the inputs are compared a word at a time
+    if ( !DG_PoseCache || n_models > DG_POSE_JOINTS ||
+#ifdef VR_EXE
+         // DG_ScreenModelsUnk400 starts from the world matrices it left last time
+         ( objs->flag & DG_FLAG_UNKNOWN_400 ) ||
+#endif
+         ( ( (u_long)objs->rots | (u_long)objs->movs | (u_long)objs->adjust | (u_long)objs->waist_rot ) & 3 ) )
+    {
+        DG_PoseStats[ DG_POSE_STAT_UNCACHED ]++;
+        DG_PoseStats[ DG_POSE_STAT_JOINTS ] += n_models;
+        return 0;
+    }
+
+    pose = &dg_pose_slots[ ( (u_long)objs >> 3 ) % DG_POSE_SLOTS ];
+
+    same = pose->objs == objs && pose->def == objs->def && pose->kind == kind &&
+           pose->inputs == inputs && pose->n_models == n_models;
+
+    pose->objs = objs;
+    pose->def = objs->def;
+    pose->kind = kind;
+    pose->inputs = inputs;
+    pose->n_models = n_models;
+
+    same &= dg_pose_sync( (u_long *)&pose->eye, (u_long *)getScratchAddr( 0 ), sizeof( MATRIX ) / 4 );
+    same &= dg_pose_sync( (u_long *)&pose->world, (u_long *)&objs->world, sizeof( MATRIX ) / 4 );
+
+    if ( eye_t )
+    {
+        same &= dg_pose_sync( (u_long *)pose->eye_t, (u_long *)eye_t, 3 );
+    }
+
+    if ( inputs & DG_POSE_ROTS )
+    {
+        same &= dg_pose_sync( (u_long *)pose->joints, (u_long *)objs->rots, n_models * 2 );
+    }
+
+    if ( inputs & DG_POSE_MOVS )
+    {
+        same &= dg_pose_sync( (u_long *)pose->joints, (u_long *)objs->movs, n_models * 2 );
+    }
+
+    if ( inputs & DG_POSE_ADJUST )
+    {
+        same &= dg_pose_sync( (u_long *)pose->adjust, (u_long *)objs->adjust, n_models * 2 );
+    }
+
+    if ( inputs & DG_POSE_WAIST )
+    {
+        same &= dg_pose_sync( (u_long *)&pose->waist_rot, (u_long *)objs->waist_rot, 2 );
+    }
+
+    if ( same )
+    {
+        DG_PoseStats[ DG_POSE_STAT_KEPT ]++;
+        DG_PoseStats[ DG_POSE_STAT_JOINTS_KEPT ] += n_models;
+    }
+    else
+    {
+        DG_PoseStats[ DG_POSE_STAT_COMPOSED ]++;
+        DG_PoseStats[ DG_POSE_STAT_JOINTS ] += n_models;
+    }
+
+    return same;
+}
+
+/* Called when objs is freed, since another one may be allocated in its place */
+void DG_PoseForget( DG_OBJS *objs )
+{
+    DG_POSE *pose;
+
+    pose = &dg_pose_slots[ ( (u_long)objs >> 3 ) % DG_POSE_SLOTS ];
+    if ( pose->objs == objs )
+    {
+        pose->objs = NULL;
+    }
+}
+
+static void dg_pose_bench_clear( void )
+{
+    int i;
+
+    for ( i = 0; i < DG_POSE_STAT_MAX; i++ )
+    {
+        DG_PoseStats[ i ] = 0;
+    }
+
+    dg_pose_hsyncs = 0;
+    dg_pose_calls = 0;
+}
+
+void DG_PoseBenchStart( void )
+{
+    // the stats count from when the bench was turned on
+    if ( DG_PoseBench && !dg_pose_bench_on )
+    {
+        dg_pose_bench_clear();
+    }
+
+    dg_pose_bench_on = DG_PoseBench;
+    dg_pose_intime = GetRCnt( RCntCNT1 );
+}
+
+/* With DG_PoseBench set, reports the screen pass every DG_POSE_BENCH_CALLS
+ * calls and turns the cache on or off for the next lot, to compare both */
+void DG_PoseBenchEnd( void )
+{
+    int calls;
+    int i;
+
+    if ( !dg_pose_bench_on )
+    {
+        return;
+    }
+
+    dg_pose_hsyncs += ( GetRCnt( RCntCNT1 ) - dg_pose_intime ) & 0xffff;
+
+    if ( ++dg_pose_calls < DG_POSE_BENCH_CALLS )
+    {
+        return;
+    }
+
+    calls = dg_pose_calls;
+    printf( "screen %s: %d.%02d hsync/pass, objs %d composed %d kept %d uncached, joints %d composed %d kept\n",
+            DG_PoseCache ? "cache" : "no cache",
+            dg_pose_hsyncs / calls, ( ( dg_pose_hsyncs % calls ) * 100 ) / calls,
+            DG_PoseStats[ DG_POSE_STAT_COMPOSED ], DG_PoseStats[ DG_POSE_STAT_KEPT ],
+            DG_PoseStats[ DG_POSE_STAT_UNCACHED ], DG_PoseStats[ DG_POSE_STAT_JOINTS ],
+            DG_PoseStats[ DG_POSE_STAT_JOINTS_KEPT ] );
+
+    dg_pose_bench_clear();
+
+    // the cache is filled again from scratch when it comes back on
+    if ( DG_PoseCache )
+    {
+        for ( i = 0; i < DG_POSE_SLOTS; i++ )
+        {
+            dg_pose_slots[ i ].objs = NULL;
+        }
+    }
+
+    DG_PoseCache = !DG_PoseCache;
+}
+#endif
+
 STATIC void DG_ScreenModelsSingle( DG_OBJS *objs, int n_models )
 {
     DG_OBJ *obj;
@@ -402,6 +634,13 @@ STATIC void DG_ScreenObjs( DG_OBJS *objs )
 
     *(MATRIX *)getScratchAddr(8) = objs->world;
 
+#ifdef DEV_EXE
+    if (DG_PoseUnchanged(objs, 0, NULL))
+    {
+        return;
+    }
+#endif
+
     if (objs->flag & DG_FLAG_ONEPIECE)
     {
         DG_ScreenModelsSingle(objs, n_models);
@@ -437,8 +676,16 @@ void DG_ScreenChanl( DG_CHANL *chanl, int idx )
     *(MATRIX *)getScratchAddr(0) = chanl->eye_inv;
     DG_AdjustOverscan((MATRIX *)getScratchAddr(0));
 
+#ifdef DEV_EXE
+    DG_PoseBenchStart();
+#endif
+
     for (i = chanl->mTotalObjectCount; i > 0; i--)
     {
         DG_ScreenObjs(*queue++);
     }
+
+#ifdef DEV_EXE
+    DG_PoseBenchEnd();
+#endif
 }
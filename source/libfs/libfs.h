@@ -118,5 +118,17 @@ int  FS_StreamIsForceStop(void);
 void FS_StreamTickStart(void);
 void FS_StreamSoundMode(void);
 int  FS_StreamGetTick(void);
+#ifdef DEV_EXE
+typedef void (*FS_STREAM_PRODUCER)(void *buffer, int sector, cdbios_task_pfn callback);
+
+extern FS_STREAM_PRODUCER fs_stream_producer;
+
+int  FS_StreamCountData(int target_type);
+
+/* contrib/dev/stream_bench.c */
+extern int stream_bench_request;
+
+void FS_StreamBench(void);
+#endif
 
 #endif // __MGS_LIBFS_H__
@@ -28,6 +28,96 @@ STATIC int  fs_stream_stop = 0;
 STATIC int  fs_stream_end = 1;
 STATIC int *fs_stream_unread = NULL;
 
+#ifdef DEV_EXE
+/*
+ * Per-type resume cursors for FS_StreamGetData (dev only).
+ *
+ * A cursor remembers the last packet handed out for a type. Every packet
+ * of that type in front of it has already been claimed or cleared, so the
+ * next lookup can start there instead of walking from fs_stream_top.
+ * Cursors are dropped whenever packets are relocated to the heap start,
+ * when fs_stream_top moves past them and when a packet is ungot.
+ */
+#define FS_STREAM_CURSOR_TYPES  0x20
+
+STATIC char *fs_stream_cursor[FS_STREAM_CURSOR_TYPES];
+STATIC int   fs_stream_get_calls;
+STATIC int   fs_stream_get_steps;
+
+/*
+ * Running packet counts for FS_StreamCountData. The unclaimed packets of a
+ * type are those that arrived less those taken (claimed or cleared). Each
+ * array has a single writer, so the CD callback never races a consumer:
+ * arrived is only written by StreamReadyCallback, and taken only by the
+ * consumer of that type.
+ */
+STATIC int   fs_stream_arrived[FS_STREAM_CURSOR_TYPES];
+STATIC int   fs_stream_taken[FS_STREAM_CURSOR_TYPES];
+
+// Stands in for CDBIOS_ReadRequest when set, see contrib/dev/stream_bench.c
+FS_STREAM_PRODUCER fs_stream_producer;
+
+static inline int StreamDistance( char *from, char *to )
+{
+    int diff = to - from;
+
+    if (diff < 0)
+    {
+        diff += fs_stream_heap_size;
+    }
+
+    return diff;
+}
+
+static void StreamResetCounts( void )
+{
+    int i;
+
+    for (i = 0; i < FS_STREAM_CURSOR_TYPES; i++)
+    {
+        fs_stream_arrived[i] = 0;
+        fs_stream_taken[i] = 0;
+    }
+}
+
+/* An unclaimed packet that is cleared without being got */
+static void StreamTakeTag( int tag )
+{
+    tag &= 0xFF;
+
+    if (tag != 0 && tag < FS_STREAM_CURSOR_TYPES)
+    {
+        fs_stream_taken[tag]++;
+    }
+}
+
+static void StreamResetCursors( void )
+{
+    int i;
+
+    for (i = 0; i < FS_STREAM_CURSOR_TYPES; i++)
+    {
+        fs_stream_cursor[i] = NULL;
+    }
+}
+
+static void StreamCheckCursors( void )
+{
+    int live;
+    int i;
+
+    live = StreamDistance(fs_stream_top, fs_stream_bottom);
+
+    for (i = 0; i < FS_STREAM_CURSOR_TYPES; i++)
+    {
+        if (fs_stream_cursor[i] && StreamDistance(fs_stream_top, fs_stream_cursor[i]) >= live)
+        {
+            fs_stream_cursor[i] = NULL;
+        }
+    }
+}
+#endif
+
 static int StreamReadyCallback( CDBIOS_TASK *task )
 {
     int retval;
@@ -55,6 +145,12 @@ static int StreamReadyCallback( CDBIOS_TASK *task )
 
             if ((char *)&fs_stream_write_ptr[-1] >= charPtr2)
             {
+#ifdef DEV_EXE
+                if ((*(int *)charPtr1 & 0xFF) < FS_STREAM_CURSOR_TYPES)
+                {
+                    fs_stream_arrived[*(int *)charPtr1 & 0xFF]++;
+                }
+#endif
                 charPtr1 = charPtr2;
 
                 if (*charPtr2 != 0xF0)
@@ -105,6 +201,9 @@ static int StreamReadyCallback( CDBIOS_TASK *task )
 
             *(int *)charPtr1 = -1;
             retval = 2;
+#ifdef DEV_EXE
+            StreamResetCursors();
+#endif
 
             fs_stream_write_ptr = memcpyDst;
             fs_stream_heap_end =
@@ -192,6 +291,9 @@ static void StartRead( void )
         fs_stream_write_ptr = var_a1;
         *temp_v0 = -1;
         fs_stream_unread = NULL;
+#ifdef DEV_EXE
+        StreamResetCursors();
+#endif
         new_var = (fs_stream_heap_size - ((int)var_a1 - (int)fs_stream_heap)) & ~0x7FF;
         fs_stream_heap_end = (char *)var_a1 + new_var;
         fs_stream_bottom = fs_stream_heap;
@@ -200,6 +302,13 @@ static void StartRead( void )
     }
 
     fs_stream_read = 1;
+#ifdef DEV_EXE
+    if (fs_stream_producer)
+    {
+        fs_stream_producer(fs_stream_write_ptr, fs_stream_sector, &StreamReadyCallback);
+        return;
+    }
+#endif
     CDBIOS_ReadRequest(fs_stream_write_ptr, fs_stream_sector, 0, &StreamReadyCallback);
 }
 
@@ -221,6 +330,13 @@ void FS_StreamTaskStart( int sector )
     fs_stream_bottom = fs_stream_heap;
     fs_stream_write_ptr = fs_stream_heap;
 
+#ifdef DEV_EXE
+    StreamResetCursors();
+    StreamResetCounts();
+    fs_stream_get_calls = 0;
+    fs_stream_get_steps = 0;
+#endif
+
     StartRead();
 }
 
@@ -289,6 +405,10 @@ int FS_StreamSync( void )
     }
     fs_stream_top = ptr;
 
+#ifdef DEV_EXE
+    StreamCheckCursors();
+#endif
+
     if (stream_read == 0 && stream_end == 0)
     {
         remaining = (char *)fs_stream_write_ptr - fs_stream_top;
@@ -383,11 +503,25 @@ void *FS_StreamGetData( int target_type )
     }
 
     ptr = fs_stream_top;
+
+#ifdef DEV_EXE
+    fs_stream_get_calls++;
+
+    if (target_type < FS_STREAM_CURSOR_TYPES && fs_stream_cursor[target_type])
+    {
+        ptr = fs_stream_cursor[target_type];
+    }
+#endif
+
     while (ptr != fs_stream_bottom)
     {
         type = *(int *)ptr & 0xFF;
         size = *(int *)ptr >> 8;
 
+#ifdef DEV_EXE
+        fs_stream_get_steps++;
+#endif
+
         if (type == 0xff)
         {
             ptr = fs_stream_heap;
@@ -397,6 +531,13 @@ void *FS_StreamGetData( int target_type )
             if (type == target_type)
             {
                 *ptr = type | 0x80;
+#ifdef DEV_EXE
+                if (target_type < FS_STREAM_CURSOR_TYPES)
+                {
+                    fs_stream_cursor[target_type] = ptr;
+                    fs_stream_taken[target_type]++;
+                }
+#endif
                 return ptr + 4;
             }
 
@@ -412,6 +553,19 @@ void *FS_StreamGetData( int target_type )
     return NULL;
 }
 
+#ifdef DEV_EXE
+// Counts the unclaimed packets of a type that are already in the heap.
+int FS_StreamCountData( int target_type )
+{
+    if (fs_stream_stop != 0 || target_type <= 0 || target_type >= FS_STREAM_CURSOR_TYPES)
+    {
+        return 0;
+    }
+
+    return fs_stream_arrived[target_type] - fs_stream_taken[target_type];
+}
+#endif
+
 int FS_StreamGetSize( void *stream )
 {
     int *tag;
@@ -431,6 +585,16 @@ void FS_StreamUngetData( void *stream )
     if (val & 0x80)
     {
         *(char *)tag = val & ~0x80;
+
+#ifdef DEV_EXE
+        // The packet is visible again, so lookups for its type
+        // have to start from fs_stream_top once more.
+        if ((val & 0x7F) < FS_STREAM_CURSOR_TYPES)
+        {
+            fs_stream_cursor[val & 0x7F] = NULL;
+            fs_stream_taken[val & 0x7F]--;
+        }
+#endif
     }
 }
 
@@ -439,6 +603,9 @@ void FS_StreamClear( void *stream )
     int *tag;
 
     tag = (int *)((char *)stream - 4);
+#ifdef DEV_EXE
+    StreamTakeTag(*tag);
+#endif
     *tag &= ~0xff;
 }
 
@@ -464,6 +631,9 @@ void FS_StreamClearType( void *stream, int target_type )
 
         if (type == target_type)
         {
+#ifdef DEV_EXE
+            StreamTakeTag(*(int *)ptr);
+#endif
             ptr[0] = 0;
             printf("clear %X\n", size);
         }
@@ -487,6 +657,9 @@ void FS_StreamDump( void )
 
     printf("now_data_top %X loaded_header %X\n", (unsigned int)ptr, (unsigned int)fs_stream_bottom);
     printf("Tick %d\n", FS_StreamGetTick());
+#ifdef DEV_EXE
+    printf("GetData calls %d steps %d\n", fs_stream_get_calls, fs_stream_get_steps);
+#endif
 
     while (ptr != fs_stream_bottom)
     {
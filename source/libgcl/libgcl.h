@@ -200,5 +200,20 @@ void            GCL_RestoreVar(void);
 unsigned char  *GCL_GetVar(unsigned char *top, int *type_p, int *value_p);
 unsigned char  *GCL_SetVar(unsigned char *top, unsigned int value);
 unsigned char  *GCL_VarSaveBuffer(unsigned char *top);
+#ifdef DEV_EXE
+unsigned long   GCL_CrcUpdate(unsigned long crc, unsigned char *ptr, int len);
+
+/* contrib/dev/snapshot.c */
+#define SNAP_RECORD     1
+#define SNAP_COMPARE    2
+#define SNAP_STOP       3
+
+extern int      snap_request;
+extern int      snap_frames;
+extern char     snap_file[16];
+
+void            GCL_SnapStageStart(void);
+void            GCL_SnapFrame(void);
+#endif
 
 #endif // __MGS_LIBGCL_H__
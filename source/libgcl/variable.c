@@ -51,9 +51,118 @@ void GCL_SaveLinkVar(short *gameVar)
     *(short *)(addr + offset) = *gameVar;
 }
 
+#ifdef DEV_EXE
+/*
+ * Table driven CRC-32, same polynomial and result as crc32 below.
+ * GCL_CRC_SLICES picks the tables at compile time: 1 is a byte at a time,
+ * 4 (slice-by-4) a word at a time through four tables, 8 (slice-by-8) two
+ * words at a time through eight, 0 is the original bitwise loop. There is
+ * no CRC instruction on the R3000. Both slicings do one table load per
+ * byte; slice-by-8 only halves the loop overhead, for 8 KB of tables in
+ * place of 4 KB, and the PS1 has no data cache for either to live in.
+ */
+#ifndef GCL_CRC_SLICES
+#define GCL_CRC_SLICES  4
+#endif
+
+#if GCL_CRC_SLICES > 0
+STATIC unsigned long crc_table[GCL_CRC_SLICES][256];
+STATIC int           crc_table_ready;
+
+static void crc_init_table(void)
+{
+    unsigned long crc;
+    int           i, j;
+
+    for (i = 0; i < 256; i++)
+    {
+        crc = i;
+        for (j = 8; j > 0; j--)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
+        }
+        crc_table[0][i] = crc;
+    }
+
+    for (i = 0; i < 256; i++)
+    {
+        for (j = 1; j < GCL_CRC_SLICES; j++)
+        {
+            crc = crc_table[j - 1][i];
+            crc_table[j][i] = (crc >> 8) ^ crc_table[0][crc & 0xff];
+        }
+    }
+
+    crc_table_ready = 1;
+}
+#endif
+
+/* Continues a CRC-32: start from 0xffffffff and invert the final value */
+unsigned long GCL_CrcUpdate(unsigned long crc, unsigned char *ptr, int len)
+{
+#if GCL_CRC_SLICES >= 8
+    unsigned long next;
+#endif
+#if GCL_CRC_SLICES == 0
+    int counter;
+
+    for (; len > 0; len--)
+    {
+        crc ^= *ptr++;
+        for (counter = 8; counter > 0; counter--)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
+        }
+    }
+#else
+    if (!crc_table_ready)
+    {
+        crc_init_table();
+    }
+
+#if GCL_CRC_SLICES >= 4
+    for (; len > 0 && ((unsigned long)ptr & 3); len--)
+    {
+        crc = (crc >> 8) ^ crc_table[0][(crc ^ *ptr++) & 0xff];
+    }
+
+#if GCL_CRC_SLICES >= 8
+    for (; len >= 8; len -= 8, ptr += 8)
+    {
+        crc ^= *(unsigned long *)ptr;
+        next = *(unsigned long *)(ptr + 4);
+        crc = crc_table[7][crc & 0xff] ^ crc_table[6][(crc >> 8) & 0xff] ^
+              crc_table[5][(crc >> 16) & 0xff] ^ crc_table[4][crc >> 24] ^
+              crc_table[3][next & 0xff] ^ crc_table[2][(next >> 8) & 0xff] ^
+              crc_table[1][(next >> 16) & 0xff] ^ crc_table[0][next >> 24];
+    }
+#endif
+
+    // little endian, so the first byte of the word is the low one
+    for (; len >= 4; len -= 4, ptr += 4)
+    {
+        crc ^= *(unsigned long *)ptr;
+        crc = crc_table[3][crc & 0xff] ^ crc_table[2][(crc >> 8) & 0xff] ^
+              crc_table[1][(crc >> 16) & 0xff] ^ crc_table[0][crc >> 24];
+    }
+#endif
+
+    for (; len > 0; len--)
+    {
+        crc = (crc >> 8) ^ crc_table[0][(crc ^ *ptr++) & 0xff];
+    }
+#endif
+
+    return crc;
+}
+#endif
+
 // Used for save files
 static unsigned int crc32(int len, unsigned char *ptr)
 {
+#ifdef DEV_EXE
+    return ~GCL_CrcUpdate(0xffffffff, ptr, len);
+#else
     unsigned int  crc;
     int           counter;
 
@@ -77,6 +186,7 @@ static unsigned int crc32(int len, unsigned char *ptr)
         } while (--len != 0);
     }
     return ~crc;
+#endif
 }
 
 int GCL_MakeSaveFile(char *save_buf)
@@ -14,6 +14,9 @@
 #include <libsn.h>
 #include "libgv.h"
 #include "mts/mts.h"    // for cprintf
+#ifdef DEV_EXE
+#include <libapi.h>     // for GetRCnt
+#endif
 
 // 0x0 No pause
 // 0x1 codec
@@ -152,6 +155,166 @@ void GV_DumpActorSystem(void)
     }
 }
 
+#ifdef DEV_EXE
+/*
+ * Frame budget watchdog. While GV_ActorBudget is non-zero every act callback
+ * is timed in hsyncs (RCntCNT1), accumulated in GV_ACT runtime/count (see
+ * GV_DumpActorSystem) and summed per filename and exec level for the frame.
+ * A frame whose actors take more than GV_ActorBudget hsyncs prints the
+ * heaviest entries. One NTSC frame is about 262 hsyncs.
+ */
+#define ACTOR_WATCH_ENTRIES 32
+#define ACTOR_WATCH_REPORT  5
+
+typedef struct
+{
+    const char *filename;
+    int         level;
+    int         hsyncs;
+    int         calls;
+} ACTOR_WATCH;
+
+int GV_ActorBudget = 0;
+int GV_ActorOverruns = 0;
+
+STATIC ACTOR_WATCH actor_watch[ACTOR_WATCH_ENTRIES + 1];
+STATIC int         actor_watch_count;
+
+static ACTOR_WATCH *GV_ActorWatchEntry(const char *filename, int level)
+{
+    ACTOR_WATCH *entry;
+    int          i;
+
+    entry = actor_watch;
+    for (i = actor_watch_count; i > 0; i--, entry++)
+    {
+        if (entry->filename == filename && entry->level == level)
+        {
+            return entry;
+        }
+    }
+
+    if (actor_watch_count == ACTOR_WATCH_ENTRIES)
+    {
+        // the last entry collects whatever doesn't fit
+        entry = &actor_watch[ACTOR_WATCH_ENTRIES];
+        entry->filename = "(other)";
+        entry->level = -1;
+        return entry;
+    }
+
+    actor_watch_count++;
+    entry->filename = filename;
+    entry->level = level;
+    entry->hsyncs = 0;
+    entry->calls = 0;
+    return entry;
+}
+
+static void GV_ActorWatchReport(int total)
+{
+    ACTOR_WATCH *entry, *top;
+    int          i, n;
+
+    printf("--actor budget: %d hsync > %d, %d overruns--\n",
+           total, GV_ActorBudget, GV_ActorOverruns);
+
+    for (n = ACTOR_WATCH_REPORT; n > 0; n--)
+    {
+        top = NULL;
+        entry = actor_watch;
+        for (i = ACTOR_WATCH_ENTRIES + 1; i > 0; i--, entry++)
+        {
+            if (entry->calls > 0 && (!top || entry->hsyncs > top->hsyncs))
+            {
+                top = entry;
+            }
+        }
+
+        if (!top)
+        {
+            break;
+        }
+
+        printf("Lv%d %5d hsync %3d calls %s\n", top->level, top->hsyncs,
+               top->calls, top->filename ? top->filename : "(noname)");
+
+        // taken out of the next searches
+        top->calls = 0;
+    }
+}
+
+/* GV_ExecActorSystem with every act callback timed. */
+static void GV_ExecActorSystemWatch(void)
+{
+    extern int GM_CurrentMap;
+
+    int          i;
+    ActorList   *lp = gActorsList_800ACC18;
+    ACTOR_WATCH *entry;
+    long         intime, outtime;
+    int          hsyncs, total;
+
+    actor_watch_count = 0;
+    actor_watch[ACTOR_WATCH_ENTRIES].hsyncs = 0;
+    actor_watch[ACTOR_WATCH_ENTRIES].calls = 0;
+    total = 0;
+
+    for (i = 0; i < GV_ACTOR_LEVEL; i++, lp++)
+    {
+        const int pause_level = GV_PauseLevel;
+        if ((lp->pause & pause_level) == 0)
+        {
+            GV_ACT *actor = &lp->first;
+            for (;;)
+            {
+                GV_ACT *current = actor;
+                GV_ACT *next = current->next;
+                if (current->act)
+                {
+                    entry = GV_ActorWatchEntry(current->filename, i);
+
+                    intime = GetRCnt(RCntCNT1);
+                    if (current->act == (GV_ACTFUNC)GV_DestroyActorQuick)
+                    {
+                        // the actor is freed by the call, don't touch it after
+                        current->act(current);
+                        outtime = GetRCnt(RCntCNT1);
+                        hsyncs = (outtime - intime) & 0xffff;
+                    }
+                    else
+                    {
+                        current->act(current);
+                        outtime = GetRCnt(RCntCNT1);
+                        hsyncs = (outtime - intime) & 0xffff;
+
+                        current->runtime += hsyncs;
+                        current->count++;
+                    }
+
+                    entry->hsyncs += hsyncs;
+                    entry->calls++;
+                    total += hsyncs;
+                }
+
+                GM_CurrentMap = 0;
+                actor = next;
+                if (!next)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (total > GV_ActorBudget)
+    {
+        GV_ActorOverruns++;
+        GV_ActorWatchReport(total);
+    }
+}
+#endif // DEV_EXE
+
 /**
  * @brief Execute all actors in the actor system.
  * Iterate over all actors in all actor lists and call their update function.
@@ -164,6 +327,24 @@ void GV_ExecActorSystem(void)
     int         i;
     ActorList  *lp = gActorsList_800ACC18;
 
+#ifdef DEV_EXE
+    if (actor_bench_request)
+    {
+        GV_ActorBench();
+    }
+
+    if (actor_bench_pool)
+    {
+        GV_ActorBenchPool();
+    }
+
+    if (GV_ActorBudget)
+    {
+        GV_ExecActorSystemWatch();
+        return;
+    }
+#endif
+
     // for every actor list
     for (i = GV_ACTOR_LEVEL; i > 0; i--)
     {
@@ -280,6 +461,81 @@ void *GV_NewActor(int exec_level, int size)
     return (void *)actor;
 }
 
+#ifdef DEV_EXE
+/**
+ * @brief Allocate an actor from a fixed-size block pool and initialize it.
+ * The actor comes from the GV heap instead when it is larger than the pool's
+ * blocks or when the pool is empty, and free_func must hand it back to
+ * GV_FreePoolActor, which tells the two apart.
+ *
+ * @param pool The pool, see GV_POOL_INIT.
+ * @param exec_level The id of the execution list where the actor will be added.
+ * @param size The size of the actor.
+ * @param free_func The function to call when freeing the actor.
+ * @return GV_ACT* The allocated actor.
+ */
+void *GV_NewPoolActor(GV_POOL *pool, int exec_level, int size, GV_FREEFUNC free_func)
+{
+    GV_ACT *actor;
+
+    actor = NULL;
+
+    if (size <= pool->size)
+    {
+        if (pool->free)
+        {
+            actor = pool->free;
+            pool->free = *(void **)actor;
+        }
+        else if (pool->fresh < pool->count)
+        {
+            actor = (GV_ACT *)(pool->base + pool->fresh * pool->size);
+            pool->fresh++;
+        }
+    }
+
+    if (!actor)
+    {
+        pool->misses++;
+
+        actor = GV_Malloc(size);
+        if (!actor)
+        {
+            return NULL;
+        }
+    }
+    else if (++pool->used > pool->peak)
+    {
+        pool->peak = pool->used;
+    }
+
+    GV_ZeroMemory(actor, size);
+    GV_InitActor(exec_level, actor, free_func);
+    return (void *)actor;
+}
+
+/**
+ * @brief Return an actor allocated by GV_NewPoolActor.
+ *
+ * @param pool The pool the actor was allocated from.
+ * @param actor The actor to free.
+ */
+void GV_FreePoolActor(GV_POOL *pool, void *actor)
+{
+    char *block = (char *)actor;
+
+    if (block < pool->base || block >= pool->base + pool->count * pool->size)
+    {
+        GV_Free(actor);
+        return;
+    }
+
+    *(void **)block = pool->free;
+    pool->free = block;
+    pool->used--;
+}
+#endif // DEV_EXE
+
 void GV_SetNamedActor(void *actor, void *act_func,
                       void *die_func, const char *filename)
 {
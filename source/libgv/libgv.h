@@ -114,6 +114,17 @@ enum {
 #ifndef __GV_ACTOR_SBSS__
 extern int GV_PauseLevel;
 #endif
+#ifdef DEV_EXE
+extern int GV_ActorBudget;      /* hsyncs per frame, 0 disables the watchdog */
+extern int GV_ActorOverruns;    /* frames over GV_ActorBudget */
+
+/* contrib/dev/actor_bench.c */
+extern int actor_bench_request;
+extern int actor_bench_pool;
+
+void GV_ActorBench(void);
+void GV_ActorBenchPool(void);
+#endif
 
 void GV_InitActorSystem(void);
 void GV_ConfigActorSystem(int exec_level, short pause, short kill);
@@ -126,6 +137,28 @@ void *GV_NewActor(int exec_level, int size);
 void GV_SetNamedActor(void *actor, void *act_func, void *die_func,
                       const char *filename);
 
+#ifdef DEV_EXE
+/* fixed-size actor blocks, handed out in order then recycled via 'free' */
+typedef struct
+{
+    char       *base;
+    int         size;
+    int         count;
+    int         fresh;      // blocks handed out at least once
+    void       *free;       // list of returned blocks
+    int         used;
+    int         peak;
+    int         misses;     // allocations that went to the GV heap
+} GV_POOL;
+
+/* buf is an array of blocks, e.g. STATIC SparkWork pool_buf[16] */
+#define GV_POOL_INIT(buf) \
+    { (char *)(buf), sizeof((buf)[0]), sizeof(buf) / sizeof((buf)[0]) }
+
+void *GV_NewPoolActor(GV_POOL *pool, int exec_level, int size, GV_FREEFUNC free_func);
+void GV_FreePoolActor(GV_POOL *pool, void *actor);
+#endif
+
 #define GV_SetActor(_actor, _act, _die) \
     GV_SetNamedActor(_actor, _act, _die, __FILE__)
 
@@ -341,6 +374,19 @@ void GV_OriginPadSystem(int);
 int  GV_GetPadOrigin(void);
 int  GV_GetPadDirNoPadOrg(unsigned int);
 
+#ifdef DEV_EXE
+/* contrib/dev/pad_rec.c */
+#define PAD_REC_RECORD  1
+#define PAD_REC_REPLAY  2
+#define PAD_REC_STOP    3
+
+extern int  pad_rec_request;
+extern char pad_rec_file[16];
+
+void GV_PadRecStageStart(void);
+void GV_PadRecFrame(void);
+#endif
+
 /*------ Math Operations ----------------------------------------------------*/
 
 /* math.c */
@@ -386,6 +386,10 @@ void GV_UpdatePadSystem(void)
         pad++;
         button = (button >> 16) & 0xFFFF;
     }
+
+#ifdef DEV_EXE
+    GV_PadRecFrame();
+#endif
 }
 
 void GV_OriginPadSystem(int org)
@@ -781,6 +781,8 @@ int HZD_LineCheck(HZD_HDL *hzd, SVECTOR *from, SVECTOR *to, int flag, int exclud
     char     *pFlagsEnd2;
     HZD_HDL  *pNextMap;
 
+    HZD_STAT(HZD_STAT_LINE);
+
     current_group = HZD_CurrentGroup;
 
     CopySvectorToSpad(6, from);
@@ -952,6 +954,345 @@ void HZD_LineNearVec(SVECTOR *out)
     out->vz = hit->z;
 }
 
+#ifdef DEV_EXE
+/*
+ * Batched line checks: the walls and floors that can touch any of the rays
+ * are gathered once against the union of their bounds, then every ray is
+ * tested against that short list only. The per-ray tests are the ones used
+ * by HZD_LineCheck, in the same order, so the results are identical.
+ */
+#define LINE_BATCH_WALLS    512
+#define LINE_BATCH_FLOORS   256
+
+typedef struct LINE_BATCH_WALL
+{
+    HZD_SEG *seg;
+    char    *flags_end;     // TestSegment reads the flags from here
+    short    count;         // index from the end of the list
+    short    dynamic;       // 0x80 for dynamic segments
+    short    n_flat;
+    short    flag;
+} LINE_BATCH_WALL;
+
+STATIC LINE_BATCH_WALL line_batch_walls[LINE_BATCH_WALLS];
+STATIC HZD_FLR        *line_batch_floors[LINE_BATCH_FLOORS];
+STATIC int             line_batch_n_walls;
+STATIC int             line_batch_n_floors;
+
+// same test as CheckWallBounds, on world space bounds
+static int LineBatchWallBounds(HZD_SEG *seg, SVECTOR *min, SVECTOR *max)
+{
+    int z1, z2;
+
+    if (seg->p1.x > max->vx || seg->p2.x < min->vx)
+    {
+        return 0;
+    }
+
+    z1 = seg->p1.z;
+    z2 = seg->p2.z;
+    if (z1 > z2)
+    {
+        SWAP(swap, z1, z2);
+    }
+
+    if (z1 > max->vz || z2 < min->vz)
+    {
+        return 0;
+    }
+
+    if (seg->p1.y > max->vy && seg->p2.y > max->vy)
+    {
+        return 0;
+    }
+
+    if (seg->p1.y + seg->p1.h < min->vy && seg->p2.y + seg->p2.h < min->vy)
+    {
+        return 0;
+    }
+
+    return 1;
+}
+
+// same test as sub_helper_80027F10, on world space bounds
+static int LineBatchFloorBounds(HZD_FLR *floor, SVECTOR *min, SVECTOR *max)
+{
+    if (floor->b1.z > max->vz || floor->b2.z < min->vz ||
+        floor->b1.x > max->vx || floor->b2.x < min->vx ||
+        floor->b1.y > max->vy || floor->b2.y < min->vy)
+    {
+        return 0;
+    }
+
+    return 1;
+}
+
+static int LineBatchAddWall(HZD_SEG *seg, char *flags_end, int count, int dynamic, int n_flat, int flag)
+{
+    LINE_BATCH_WALL *wall;
+
+    if (line_batch_n_walls >= LINE_BATCH_WALLS)
+    {
+        return 0;
+    }
+
+    wall = &line_batch_walls[line_batch_n_walls++];
+    wall->seg = seg;
+    wall->flags_end = flags_end;
+    wall->count = count;
+    wall->dynamic = dynamic;
+    wall->n_flat = n_flat;
+    wall->flag = flag;
+    return 1;
+}
+
+static int LineBatchAddFloor(HZD_FLR *floor, SVECTOR *min, SVECTOR *max)
+{
+    if (!LineBatchFloorBounds(floor, min, max))
+    {
+        return 1;
+    }
+
+    if (line_batch_n_floors >= LINE_BATCH_FLOORS)
+    {
+        return 0;
+    }
+
+    line_batch_floors[line_batch_n_floors++] = floor;
+    return 1;
+}
+
+/* Returns 0 if the candidates don't fit, the caller then checks ray by ray. */
+static int LineBatchGather(HZD_HDL *hzd, SVECTOR *min, SVECTOR *max, int flag, int exclude)
+{
+    HZD_GRP  *group;
+    HZD_SEG  *wall;
+    HZD_SEG **walls;
+    HZD_FLR  *floor;
+    HZD_FLR **floors;
+    HZD_HDL  *map;
+    char     *flags;
+    char     *flags_end;
+    int       n_groups, bit;
+    int       count;
+
+    line_batch_n_walls = 0;
+    line_batch_n_floors = 0;
+
+    if (flag & HZD_CHECK_SEG)
+    {
+        group = hzd->header->groups;
+        for (n_groups = hzd->header->n_groups, bit = 1; n_groups > 0; n_groups--, bit <<= 1, group++)
+        {
+            if (!(HZD_CurrentGroup & bit))
+            {
+                continue;
+            }
+
+            wall = group->walls;
+            flags = group->wallsFlags;
+            flags_end = flags + 2 * group->n_walls;
+
+            for (count = group->n_walls; count > 0; count--, wall++, flags++)
+            {
+                if (!(*flags & exclude) && LineBatchWallBounds(wall, min, max) &&
+                    !LineBatchAddWall(wall, flags_end, count, 0, group->n_flat_walls, *flags))
+                {
+                    return 0;
+                }
+            }
+        }
+    }
+
+    if (flag & HZD_CHECK_DYNSEG)
+    {
+        map = NULL;
+        while ((map = GM_IterHazard(map)))
+        {
+            walls = map->dynamic_segments;
+            flags = map->dynamic_flags;
+            flags_end = flags + map->max_dynamic_segments + map->dynamic_queue_index;
+
+            for (count = map->dynamic_queue_index; count > 0; count--, walls++, flags++)
+            {
+                if (!(*flags & exclude) && LineBatchWallBounds(*walls, min, max) &&
+                    !LineBatchAddWall(*walls, flags_end, count, 0x80, 0, *flags))
+                {
+                    return 0;
+                }
+            }
+        }
+    }
+
+    if (flag & HZD_CHECK_FLR)
+    {
+        group = hzd->header->groups;
+        for (n_groups = hzd->header->n_groups, bit = 1; n_groups > 0; n_groups--, bit <<= 1, group++)
+        {
+            if (!(HZD_CurrentGroup & bit))
+            {
+                continue;
+            }
+
+            floor = group->floors;
+            for (count = group->n_floors; count > 0; count--, floor++)
+            {
+                if (!LineBatchAddFloor(floor, min, max))
+                {
+                    return 0;
+                }
+            }
+        }
+    }
+
+    if (flag & HZD_CHECK_DYNFLR)
+    {
+        map = NULL;
+        while ((map = GM_IterHazard(map)))
+        {
+            floors = map->dynamic_floors;
+            for (count = map->dynamic_floor_index; count > 0; count--, floors++)
+            {
+                if (!LineBatchAddFloor(*floors, min, max))
+                {
+                    return 0;
+                }
+            }
+        }
+    }
+
+    return 1;
+}
+
+/* HZD_LineCheck against the gathered candidates. */
+static int LineBatchTest(SVECTOR *from, SVECTOR *to)
+{
+    LINE_BATCH_WALL *wall;
+    HZD_FLR        **floor;
+    int              count;
+
+    HZD_STAT(HZD_STAT_LINE);
+
+    CopySvectorToSpad(6, from);
+
+    *((int *)0x1F800064) = (*((int *)0x1F80006C) = 0);
+
+    CopySvectorToSpad(10, to);
+    CopySvector((SVECTOR *)0x1F800054, (SVECTOR *)0x1F800014);
+
+    *((int *)0x1F80008C) = 0;
+
+    ComputeBounds((SVECTOR *)0x1F80000C, (SVECTOR *)0x1F800054);
+
+    *((int *)0x1F80005C) = ComputeDirection();
+    if (!(*(int *)0x1F80005C))
+    {
+        return 0;
+    }
+
+    wall = line_batch_walls;
+    for (count = line_batch_n_walls; count > 0; count--, wall++)
+    {
+        *((short *)0x1F80006A) = wall->dynamic;
+        *((char **)0x1F800070) = wall->flags_end;
+        *((int *)0x1F800060) = wall->n_flat;
+        TestSegment(wall->seg, wall->count, wall->flag);
+    }
+
+    ComputeBounds((SVECTOR *)0x1F80000C, (SVECTOR *)0x1F800054);
+    *((int *)0x1F80005C) = HZD_80027BF8((SVECTOR *)0x1F800054);
+    *((int *)0x1F800074) = 0xF4240;
+
+    floor = line_batch_floors;
+    for (count = line_batch_n_floors; count > 0; count--, floor++)
+    {
+        TestFloor(*floor);
+    }
+
+    if (*(int *)0x1F80008C != 0)
+    {
+        gte_SetRotMatrix(0x1f800090);
+    }
+
+    if (*(int *)0x1F800064 != 0)
+    {
+        return *(int *)0x1F80006C;
+    }
+    return 0;
+}
+
+static void LineBatchResult(HZD_RAY *ray, int hit)
+{
+    ray->hit = hit;
+
+    if (hit)
+    {
+        ray->surface = HZD_LineNearSurface();
+        ray->flag = HZD_LineNearFlag();
+        HZD_LineNearVec(&ray->near);
+    }
+    else
+    {
+        ray->surface = NULL;
+        ray->flag = 0;
+        ray->near = ray->to;
+    }
+}
+
+/*
+ * Runs HZD_LineCheck for every ray, sharing the search for nearby walls and
+ * floors. Returns the number of rays that hit something.
+ */
+int HZD_LineCheckBatch(HZD_HDL *hzd, HZD_RAY *rays, int n_rays, int flag, int exclude)
+{
+    SVECTOR  min, max;
+    HZD_RAY *ray;
+    int      hits;
+    int      i;
+
+    if (n_rays <= 0)
+    {
+        return 0;
+    }
+
+    HZD_STAT(HZD_STAT_LINE_BATCH);
+
+    min = rays->from;
+    max = rays->from;
+
+    for (ray = rays, i = n_rays; i > 0; i--, ray++)
+    {
+        min.vx = MIN(min.vx, MIN(ray->from.vx, ray->to.vx));
+        min.vy = MIN(min.vy, MIN(ray->from.vy, ray->to.vy));
+        min.vz = MIN(min.vz, MIN(ray->from.vz, ray->to.vz));
+        max.vx = MAX(max.vx, MAX(ray->from.vx, ray->to.vx));
+        max.vy = MAX(max.vy, MAX(ray->from.vy, ray->to.vy));
+        max.vz = MAX(max.vz, MAX(ray->from.vz, ray->to.vz));
+    }
+
+    hits = 0;
+
+    if (!LineBatchGather(hzd, &min, &max, flag, exclude))
+    {
+        for (ray = rays, i = n_rays; i > 0; i--, ray++)
+        {
+            LineBatchResult(ray, HZD_LineCheck(hzd, &ray->from, &ray->to, flag, exclude));
+            hits += ray->hit != 0;
+        }
+
+        return hits;
+    }
+
+    for (ray = rays, i = n_rays; i > 0; i--, ray++)
+    {
+        LineBatchResult(ray, LineBatchTest(&ray->from, &ray->to));
+        hits += ray->hit != 0;
+    }
+
+    return hits;
+}
+#endif // DEV_EXE
+
 STATIC void HZD_CopyVector(SVECTOR *src, SVECTOR *dst)
 {
     dst->vx = src->vx;
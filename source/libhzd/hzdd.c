@@ -8,6 +8,11 @@ int SECTION(".sbss") dword_800AB9A4; // unused
 int SECTION(".sbss") HZD_CurrentGroup;
 int SECTION(".sbss") dword_800AB9AC; // unused
 
+#ifdef DEV_EXE
+int HZD_Stats[HZD_STAT_MAX];
+int HZD_Handlers;   // handlers made so far, for caches of map data
+#endif
+
 //------------------------------------------------------------------------------
 
 void HZD_StartDaemon(void)
@@ -108,6 +113,9 @@ HZD_HDL *HZD_MakeHandler(HZD_MAP *hzd, int areaIndex, int dynamic_segments, int
             zones = GV_Malloc((n_zones - 1) * (n_zones - 2) / 2 + (n_zones - 1));
             HZD_MakeRoute(hzd, zones);
             *(int *)hzd = (int)zones;
+#ifdef DEV_EXE
+            HZD_ResetRouteCache();
+#endif
         }
     }
 
@@ -138,6 +146,11 @@ HZD_HDL *HZD_MakeHandler(HZD_MAP *hzd, int areaIndex, int dynamic_segments, int
         }
         hzdMap->n_cameras = i;
         hzdMap->traps = (HZD_TRP *)trig;
+#ifdef DEV_EXE
+        hzdMap->zone_grid = NULL;
+        hzdMap->zone_grid_built = 0;
+        HZD_Handlers++;
+#endif
     }
 
     return hzdMap;
@@ -147,6 +160,12 @@ void HZD_FreeHandler(void *ptr)
 {
     if (ptr != NULL)
     {
+#ifdef DEV_EXE
+        if (((HZD_HDL *)ptr)->zone_grid)
+        {
+            GV_Free(((HZD_HDL *)ptr)->zone_grid);
+        }
+#endif
         GV_Free(ptr);
     }
     return;
@@ -8,6 +8,27 @@
 
 #define OFFSET_TO_PTR(ptr, offset) (*(int *)offset = (int)ptr + *(int *)offset)
 
+#ifdef DEV_EXE
+/* uniform XZ grid over the zone boxes, see HZD_MakeZoneGrid */
+typedef struct {
+    int          min_x, min_z;
+    short        cols, rows;
+    int          size;          /* cell size */
+    u_short     *cells;         /* cols * rows + 1 offsets into zones */
+    u_char      *zones;         /* zone indices, ascending per cell */
+} HZD_ZONE_GRID;
+
+/* one line of sight for HZD_LineCheckBatch */
+typedef struct {
+    SVECTOR      from;
+    SVECTOR      to;
+    int          hit;           /* HZD_LineCheck result */
+    void        *surface;       /* HZD_LineNearSurface */
+    SVECTOR      near;          /* HZD_LineNearVec, or 'to' when nothing was hit */
+    int          flag;          /* HZD_LineNearFlag */
+} HZD_RAY;
+#endif
+
 typedef struct {
     HZD_MAP     *header;
     HZD_GRP     *group;
@@ -22,6 +43,10 @@ typedef struct {
     HZD_FLR    **dynamic_floors;
     HZD_SEG    **dynamic_segments;
     char        *dynamic_flags;
+#ifdef DEV_EXE
+    HZD_ZONE_GRID *zone_grid;   /* built by the first zone query */
+    int            zone_grid_built;
+#endif
 } HZD_HDL;
 
 typedef struct {
@@ -103,6 +128,12 @@ int HZD_ZoneContains(HZD_HDL *hzd, SVECTOR *pos, int zone);
 int HZD_GetNears(HZD_HDL *hzd, int zone, int *nears);
 int HZD_MaxNear(HZD_HDL *hzd, int from, int to, int *maxdist);
 int HZD_MinNearDist(HZD_HDL *hzd, int from, int to);
+#ifdef DEV_EXE
+extern int HZD_RouteCacheEnable;
+extern int HZD_Handlers;
+
+void HZD_ResetRouteCache(void);
+#endif
 
 #define HZD_NO_ZONE (0xFF)
 
@@ -118,6 +149,9 @@ int HZD_PointCheck(HZD_HDL *hzd, SVECTOR *point, int range, int flag, int exclud
 void HZD_PointNearSurface(void **surface);
 void HZD_PointNearFlag(char *char_arr);
 void HZD_PointNearVec(SVECTOR *vectors);
+#ifdef DEV_EXE
+int HZD_LineCheckBatch(HZD_HDL *hzd, HZD_RAY *rays, int n_rays, int flag, int exclude);
+#endif
 
 #define HZD_CHECK_FLR    (0x1)
 #define HZD_CHECK_DYNFLR (0x2)
@@ -134,4 +168,25 @@ void HZD_PointNearVec(SVECTOR *vectors);
 #define HZD_SEG_NO_BEHIND    (0x40) /* player lean */
 #define HZD_SEG_NO_RADAR     (0x80) /* radar draw */
 
+#ifdef DEV_EXE
+/* per-call query counters, see contrib/dev/ai_bench.c */
+enum {
+    HZD_STAT_ADDRESS,   /* HZD_GetAddress */
+    HZD_STAT_REACH,     /* HZD_ReachTo */
+    HZD_STAT_ROUTE,     /* HZD_LinkRoute, HZD_LinkRouteEqual */
+    HZD_STAT_NAVIGATE,  /* HZD_ZoneDistance, HZD_NavigateLimit, HZD_NavigateBound */
+    HZD_STAT_LINE,      /* HZD_LineCheck, and each ray of a batch */
+    HZD_STAT_LINE_BATCH,/* HZD_LineCheckBatch */
+    HZD_STAT_HOP_HIT,   /* next hop read from the route cache */
+    HZD_STAT_HOP_MISS,  /* next hop computed from the route matrix */
+    HZD_STAT_MAX
+};
+
+extern int HZD_Stats[HZD_STAT_MAX];
+
+#define HZD_STAT(stat)  (HZD_Stats[stat]++)
+#else
+#define HZD_STAT(stat)  ((void)0)
+#endif
+
 #endif // __MGS_LIBHZD_H__
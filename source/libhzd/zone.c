@@ -2,6 +2,7 @@
 #include "common.h"
 #include "libhzd/libhzd.h"
 #include "libdg/libdg.h"
+#include "libgv/libgv.h"
 
 #define SWAP(name, a, b)                \
 do {                                    \
@@ -211,6 +212,256 @@ STATIC int DistToPoint(HZD_ZON *zone, SVECTOR *pos, int min)
     return dist;
 }
 
+#ifdef DEV_EXE
+#define ZONE_GRID_MIN_ZONES 8
+#define ZONE_GRID_MAX_CELLS 32  /* per axis */
+
+/*
+ * Builds a grid listing, for each cell, the zones whose XZ box overlaps it.
+ * FindClosestZone uses it to visit cells in rings around the position
+ * instead of measuring every zone. It is built by the first query on a
+ * handler, so handlers that never look up a zone don't pay for it.
+ */
+STATIC HZD_ZONE_GRID *HZD_MakeZoneGrid(HZD_MAP *hzm)
+{
+    HZD_ZONE_GRID *grid;
+    HZD_ZON       *zone;
+    u_short       *cells;
+    int            min_x, min_z, max_x, max_z;
+    int            x0, z0, x1, z1;
+    int            x, z;
+    int            shift, cols, rows;
+    int            total;
+    int            i;
+
+    if (hzm->n_zones < ZONE_GRID_MIN_ZONES)
+    {
+        return NULL;
+    }
+
+    zone = hzm->zones;
+    min_x = zone->x - zone->w;
+    max_x = zone->x + zone->w;
+    min_z = zone->z - zone->h;
+    max_z = zone->z + zone->h;
+
+    for (i = hzm->n_zones; i > 0; i--, zone++)
+    {
+        if (zone->x - zone->w < min_x) min_x = zone->x - zone->w;
+        if (zone->x + zone->w > max_x) max_x = zone->x + zone->w;
+        if (zone->z - zone->h < min_z) min_z = zone->z - zone->h;
+        if (zone->z + zone->h > max_z) max_z = zone->z + zone->h;
+    }
+
+    shift = 8;
+    while (((max_x - min_x) >> shift) >= ZONE_GRID_MAX_CELLS ||
+           ((max_z - min_z) >> shift) >= ZONE_GRID_MAX_CELLS)
+    {
+        shift++;
+    }
+
+    cols = ((max_x - min_x) >> shift) + 1;
+    rows = ((max_z - min_z) >> shift) + 1;
+
+    total = 0;
+    zone = hzm->zones;
+    for (i = hzm->n_zones; i > 0; i--, zone++)
+    {
+        x0 = (zone->x - zone->w - min_x) >> shift;
+        x1 = (zone->x + zone->w - min_x) >> shift;
+        z0 = (zone->z - zone->h - min_z) >> shift;
+        z1 = (zone->z + zone->h - min_z) >> shift;
+        total += (x1 - x0 + 1) * (z1 - z0 + 1);
+    }
+
+    if (total > 0xFFFF)
+    {
+        return NULL;
+    }
+
+    grid = GV_Malloc(sizeof(HZD_ZONE_GRID) + (cols * rows + 1) * sizeof(u_short) + total);
+    if (!grid)
+    {
+        return NULL;
+    }
+
+    cells = (u_short *)&grid[1];
+
+    grid->min_x = min_x;
+    grid->min_z = min_z;
+    grid->cols = cols;
+    grid->rows = rows;
+    grid->size = 1 << shift;
+    grid->cells = cells;
+    grid->zones = (u_char *)&cells[cols * rows + 1];
+
+    for (i = cols * rows; i >= 0; i--)
+    {
+        cells[i] = 0;
+    }
+
+    /* count the zones per cell, then turn the counts into start offsets */
+    zone = hzm->zones;
+    for (i = hzm->n_zones; i > 0; i--, zone++)
+    {
+        x0 = (zone->x - zone->w - min_x) >> shift;
+        x1 = (zone->x + zone->w - min_x) >> shift;
+        z0 = (zone->z - zone->h - min_z) >> shift;
+        z1 = (zone->z + zone->h - min_z) >> shift;
+
+        for (z = z0; z <= z1; z++)
+        {
+            for (x = x0; x <= x1; x++)
+            {
+                cells[z * cols + x + 1]++;
+            }
+        }
+    }
+
+    for (i = 0; i < cols * rows; i++)
+    {
+        cells[i + 1] += cells[i];
+    }
+
+    /* fill in ascending zone order, using each start offset as a cursor */
+    zone = hzm->zones;
+    for (i = 0; i < hzm->n_zones; i++, zone++)
+    {
+        x0 = (zone->x - zone->w - min_x) >> shift;
+        x1 = (zone->x + zone->w - min_x) >> shift;
+        z0 = (zone->z - zone->h - min_z) >> shift;
+        z1 = (zone->z + zone->h - min_z) >> shift;
+
+        for (z = z0; z <= z1; z++)
+        {
+            for (x = x0; x <= x1; x++)
+            {
+                grid->zones[cells[z * cols + x]++] = i;
+            }
+        }
+    }
+
+    /* the cursors now hold each cell's end, shift them back to starts */
+    for (i = cols * rows; i > 0; i--)
+    {
+        cells[i] = cells[i - 1];
+    }
+    cells[0] = 0;
+
+    return grid;
+}
+
+/*
+ * Same result as the linear scan in FindClosestZone: the lowest numbered
+ * zone at the smallest distance. A zone first met in ring r lies outside
+ * the cells of the inner rings, so its distance is at least the distance
+ * from pos to their edge and the search stops once that exceeds the best.
+ */
+STATIC int FindClosestZoneGrid(HZD_HDL *hzd, HZD_ZONE_GRID *grid, SVECTOR *pos)
+{
+    u_long   visited[256 / 32];
+    u_char  *zones, *end;
+    int      cx, cz;
+    int      x, z, r;
+    int      step;
+    int      bound, edge;
+    int      index;
+    int      dist;
+    int      min_dist;
+    int      min_zone;
+
+    for (x = 0; x < 256 / 32; x++)
+    {
+        visited[x] = 0;
+    }
+
+    cx = (pos->vx - grid->min_x) / grid->size;
+    cz = (pos->vz - grid->min_z) / grid->size;
+
+    if (cx < 0) cx = 0;
+    if (cx >= grid->cols) cx = grid->cols - 1;
+    if (cz < 0) cz = 0;
+    if (cz >= grid->rows) cz = grid->rows - 1;
+
+    min_zone = -1;
+    min_dist = 0x1000000;
+
+    for (r = 0; ; r++)
+    {
+        if (r > 0)
+        {
+            bound = pos->vx - (grid->min_x + (cx - r + 1) * grid->size);
+
+            edge = grid->min_x + (cx + r) * grid->size - pos->vx;
+            if (edge < bound) bound = edge;
+
+            edge = pos->vz - (grid->min_z + (cz - r + 1) * grid->size);
+            if (edge < bound) bound = edge;
+
+            edge = grid->min_z + (cz + r) * grid->size - pos->vz;
+            if (edge < bound) bound = edge;
+
+            if (bound > min_dist)
+            {
+                break;
+            }
+        }
+
+        for (z = cz - r; z <= cz + r; z++)
+        {
+            if (z < 0 || z >= grid->rows)
+            {
+                continue;
+            }
+
+            /* only the border of the ring, the inside was visited already */
+            step = (r == 0 || z == cz - r || z == cz + r) ? 1 : 2 * r;
+
+            for (x = cx - r; x <= cx + r; x += step)
+            {
+                if (x < 0 || x >= grid->cols)
+                {
+                    continue;
+                }
+
+                zones = &grid->zones[grid->cells[z * grid->cols + x]];
+                end = &grid->zones[grid->cells[z * grid->cols + x + 1]];
+
+                for (; zones < end; zones++)
+                {
+                    index = *zones;
+                    if (visited[index >> 5] & (1 << (index & 31)))
+                    {
+                        continue;
+                    }
+                    visited[index >> 5] |= 1 << (index & 31);
+
+                    dist = DistToPoint(&hzd->header->zones[index], pos, 0x7F000000);
+                    if (dist < min_dist || (dist == min_dist && index < min_zone))
+                    {
+                        min_dist = dist;
+                        min_zone = index;
+                    }
+                }
+            }
+        }
+
+        if (cx - r <= 0 && cx + r >= grid->cols - 1 &&
+            cz - r <= 0 && cz + r >= grid->rows - 1)
+        {
+            break;
+        }
+    }
+
+    if (min_zone < 0)
+    {
+        return 0;
+    }
+
+    return min_zone;
+}
+#endif
+
 STATIC int FindClosestZone(HZD_HDL *hzd, SVECTOR *pos)
 {
     int      min_zone;
@@ -220,6 +471,19 @@ STATIC int FindClosestZone(HZD_HDL *hzd, SVECTOR *pos)
     HZD_ZON *zone;
     int      dist;
 
+#ifdef DEV_EXE
+    if (!hzd->zone_grid_built)
+    {
+        hzd->zone_grid = HZD_MakeZoneGrid(hzd->header);
+        hzd->zone_grid_built = 1;
+    }
+
+    if (hzd->zone_grid)
+    {
+        return FindClosestZoneGrid(hzd, hzd->zone_grid, pos);
+    }
+#endif
+
     min_zone = -1;
     min_dist = 0x1000000;
 
@@ -305,6 +569,164 @@ STATIC int GetNears(HZD_HDL *hzd, int zone, int *out)
     return i;
 }
 
+#ifdef DEV_EXE
+#define ROUTE_CACHE_ROWS    8
+#define ROUTE_NO_HOP        6       /* no neighbour is closer, stay */
+#define ROUTE_UNKNOWN       0xFF
+
+/*
+ * Next-hop rows for the most recently used targets. The route matrix only
+ * depends on the zone graph, never on dynamic segments, so a row stays
+ * valid until HZD_MakeHandler builds a new matrix.
+ */
+typedef struct ROUTE_CACHE_ROW
+{
+    u_char *route;      /* hzd->route of the map the row belongs to */
+    int     key;        /* target zone, | 0x100 for NavigateNextEqual */
+    int     age;
+    u_char  slot[256];  /* per source zone, nears[] slot of the next hop */
+} ROUTE_CACHE_ROW;
+
+int HZD_RouteCacheEnable = 1;
+
+STATIC ROUTE_CACHE_ROW route_cache[ROUTE_CACHE_ROWS];
+STATIC int             route_cache_clock;
+
+void HZD_ResetRouteCache(void)
+{
+    int i;
+
+    for (i = 0; i < ROUTE_CACHE_ROWS; i++)
+    {
+        route_cache[i].route = NULL;
+    }
+}
+
+STATIC u_char *RouteCacheRow(HZD_HDL *hzd, int to, int equal)
+{
+    ROUTE_CACHE_ROW *row;
+    ROUTE_CACHE_ROW *oldest;
+    int              key;
+    int              i;
+
+    if (!HZD_RouteCacheEnable || !hzd->route || to >= hzd->header->n_zones)
+    {
+        return NULL;
+    }
+
+    key = to | (equal << 8);
+    oldest = route_cache;
+
+    row = route_cache;
+    for (i = ROUTE_CACHE_ROWS; i > 0; i--, row++)
+    {
+        if (row->route == hzd->route && row->key == key)
+        {
+            row->age = ++route_cache_clock;
+            return row->slot;
+        }
+
+        if (row->age < oldest->age)
+        {
+            oldest = row;
+        }
+    }
+
+    oldest->route = hzd->route;
+    oldest->key = key;
+    oldest->age = ++route_cache_clock;
+
+    for (i = 0; i < 256; i++)
+    {
+        oldest->slot[i] = ROUTE_UNKNOWN;
+    }
+
+    return oldest->slot;
+}
+
+/* Same choice as NavigateNext (or NavigateNextEqual), as a nears[] slot. */
+STATIC int NextHopSlot(HZD_HDL *hzd, u_char *row, int from, int to, int equal)
+{
+    u_char *nears;
+    int     min;
+    int     slot;
+    int     i;
+    int     cur;
+    int     dist;
+
+    if (row && row[from] != ROUTE_UNKNOWN)
+    {
+        HZD_STAT(HZD_STAT_HOP_HIT);
+        return row[from];
+    }
+
+    HZD_STAT(HZD_STAT_HOP_MISS);
+
+    min = 0xFF;
+    slot = ROUTE_NO_HOP;
+
+    nears = hzd->header->zones[from].nears;
+
+    for (i = 0; i < 6; i++)
+    {
+        cur = nears[i];
+        if (cur == HZD_NO_ZONE)
+        {
+            break;
+        }
+
+        dist = ZoneDistance(hzd->route, cur, to, hzd->header->n_zones);
+        if (dist < min || (equal && dist == min))
+        {
+            min = dist;
+            slot = i;
+        }
+    }
+
+    if (row && from < hzd->header->n_zones)
+    {
+        row[from] = slot;
+    }
+
+    return slot;
+}
+
+STATIC int NavigateNext(HZD_HDL *hzd, int from, int to)
+{
+    int slot;
+
+    if (from == to)
+    {
+        return to;
+    }
+
+    slot = NextHopSlot(hzd, RouteCacheRow(hzd, to, 0), from, to, 0);
+    if (slot == ROUTE_NO_HOP)
+    {
+        return from;
+    }
+
+    return hzd->header->zones[from].nears[slot];
+}
+
+STATIC int NavigateNextEqual(HZD_HDL *hzd, int from, int to)
+{
+    int slot;
+
+    if (from == to)
+    {
+        return to;
+    }
+
+    slot = NextHopSlot(hzd, RouteCacheRow(hzd, to, 1), from, to, 1);
+    if (slot == ROUTE_NO_HOP)
+    {
+        return from;
+    }
+
+    return hzd->header->zones[from].nears[slot];
+}
+#else
 STATIC int NavigateNext(HZD_HDL *hzd, int from, int to)
 {
     int     min;
@@ -384,6 +806,7 @@ STATIC int NavigateNextEqual(HZD_HDL *hzd, int from, int to)
 
     return minzone;
 }
+#endif
 
 int HZD_GetAddress(HZD_HDL *hzd, SVECTOR *pos, int addr)
 {
@@ -393,6 +816,8 @@ int HZD_GetAddress(HZD_HDL *hzd, SVECTOR *pos, int addr)
     HZD_ZON *pNavHi;
     int      temp;
 
+    HZD_STAT(HZD_STAT_ADDRESS);
+
     lo = addr & 255;
     hi = (addr >> 8) & 255;
 
@@ -511,6 +936,8 @@ int HZD_ReachTo(HZD_HDL *hzd, int from, int to)
     int from0, from1;
     int to0, to1;
 
+    HZD_STAT(HZD_STAT_REACH);
+
     from0 = from & 0xFF;
     to0 = to & 0xFF;
     from1 = (from >> 8) & 0xFF;
@@ -578,6 +1005,8 @@ int HZD_LinkRoute(HZD_HDL *hzd, int from, int to, SVECTOR *pos)
     int yl2, yh2;
     int v1, v2, v3, v4;
 
+    HZD_STAT(HZD_STAT_ROUTE);
+
     from0 = from & 0xff;
     to0 = to & 0xff;
     yl2 = to0;
@@ -642,6 +1071,8 @@ int HZD_LinkRouteEqual(HZD_HDL *hzd, int from, int to, SVECTOR *pos)
     int yl2, yh2;
     int v1, v2, v3, v4;
 
+    HZD_STAT(HZD_STAT_ROUTE);
+
     from0 = from & 0xff;
     to0 = to & 0xff;
     yl2 = to0;
@@ -704,29 +1135,54 @@ int HZD_LinkRouteEqual(HZD_HDL *hzd, int from, int to, SVECTOR *pos)
 int HZD_ZoneDistance(HZD_HDL *hzd, int from, int to)
 {
     HZD_MAP *hzm;
+#ifndef DEV_EXE
     int      n_zones;
+#endif
     int      total;
     HZD_ZON *zone;
+#ifndef DEV_EXE
     int      min;
+#endif
     int      minzone;
     int      mindist;
     int      i;
+#ifndef DEV_EXE
     int      cur;
     int      dist;
+#else
+    u_char  *row;
+#endif
+
+    HZD_STAT(HZD_STAT_NAVIGATE);
 
     hzm = hzd->header;
+#ifndef DEV_EXE
     n_zones = hzm->n_zones;
+#endif
 
     total = 0;
+#ifdef DEV_EXE
+    row = RouteCacheRow(hzd, to, 0);
+#endif
 
     while (from != to)
     {
         zone = &hzm->zones[from];
 
+#ifndef DEV_EXE
         min = 0xFF;
+#endif
         minzone = from;
         mindist = 0;
 
+#ifdef DEV_EXE
+        i = NextHopSlot(hzd, row, from, to, 0);
+        if (i != ROUTE_NO_HOP)
+        {
+            minzone = zone->nears[i];
+            mindist = zone->dists[i];
+        }
+#else
         for (i = 0; i < 6; i++)
         {
             cur = zone->nears[i];
@@ -743,6 +1199,7 @@ int HZD_ZoneDistance(HZD_HDL *hzd, int from, int to)
                 mindist = zone->dists[i];
             }
         }
+#endif
 
         total += mindist;
         if (minzone == from)
@@ -761,29 +1218,54 @@ int HZD_ZoneDistance(HZD_HDL *hzd, int from, int to)
 int HZD_NavigateLimit(HZD_HDL *hzd, int from, int to, int limit)
 {
     HZD_MAP *hzm;
+#ifndef DEV_EXE
     int      n_zones;
+#endif
     int      total;
     HZD_ZON *zone;
+#ifndef DEV_EXE
     int      min;
+#endif
     int      minzone;
     int      mindist;
     int      i;
+#ifndef DEV_EXE
     int      cur;
     int      dist;
+#else
+    u_char  *row;
+#endif
+
+    HZD_STAT(HZD_STAT_NAVIGATE);
 
     hzm = hzd->header;
+#ifndef DEV_EXE
     n_zones = hzm->n_zones;
+#endif
 
     total = 0;
+#ifdef DEV_EXE
+    row = RouteCacheRow(hzd, to, 0);
+#endif
 
     while (from != to)
     {
         zone = &hzm->zones[from];
 
+#ifndef DEV_EXE
         min = 0xFF;
+#endif
         minzone = from;
         mindist = 0;
 
+#ifdef DEV_EXE
+        i = NextHopSlot(hzd, row, from, to, 0);
+        if (i != ROUTE_NO_HOP)
+        {
+            minzone = zone->nears[i];
+            mindist = zone->dists[i];
+        }
+#else
         for (i = 0; i < 6; i++)
         {
             cur = zone->nears[i];
@@ -800,6 +1282,7 @@ int HZD_NavigateLimit(HZD_HDL *hzd, int from, int to, int limit)
                 mindist = zone->dists[i];
             }
         }
+#endif
 
         total += mindist;
         if (total > limit)
@@ -823,29 +1306,54 @@ int HZD_NavigateBound(HZD_HDL *hzd, int from, int to, int limit)
 {
     SVECTOR  pos;
     HZD_MAP *hzm;
+#ifndef DEV_EXE
     int      n_zones;
+#endif
     int      total;
     HZD_ZON *zone;
+#ifndef DEV_EXE
     int      min;
+#endif
     int      minzone;
     int      mindist;
     int      i;
+#ifndef DEV_EXE
     int      cur;
     int      dist;
+#else
+    u_char  *row;
+#endif
+
+    HZD_STAT(HZD_STAT_NAVIGATE);
 
     hzm = hzd->header;
+#ifndef DEV_EXE
     n_zones = hzm->n_zones;
+#endif
 
     total = 0;
+#ifdef DEV_EXE
+    row = RouteCacheRow(hzd, to, 0);
+#endif
 
     while (from != to)
     {
         zone = &hzm->zones[from];
 
+#ifndef DEV_EXE
         min = 0xFF;
+#endif
         minzone = from;
         mindist = 0;
 
+#ifdef DEV_EXE
+        i = NextHopSlot(hzd, row, from, to, 0);
+        if (i != ROUTE_NO_HOP)
+        {
+            minzone = zone->nears[i];
+            mindist = zone->dists[i];
+        }
+#else
         for (i = 0; i < 6; i++)
         {
             cur = zone->nears[i];
@@ -862,6 +1370,7 @@ int HZD_NavigateBound(HZD_HDL *hzd, int from, int to, int limit)
                 mindist = zone->dists[i];
             }
         }
+#endif
 
         total += mindist;
         if (total > limit)
@@ -5,6 +5,9 @@
 #include <kernel.h>
 #include <libapi.h>
 #include "psxdefs.h"
+#ifdef DEV_EXE
+#include <libetc.h>
+#endif
 
 #include "common.h"
 #include "mts/mts.h"
@@ -30,6 +33,28 @@ static void memcard_hwcard_do_op(int op);
 static void memcard_swcard_do_op(int op);
 static int memcard_dummy(int state);
 
+#ifdef DEV_EXE
+// the read or write memcard_get_status is waiting for, to time it
+STATIC const char *memcard_op_name;
+STATIC int         memcard_op_vblank;
+
+static void memcard_op_start(const char *name)
+{
+    memcard_op_name = name;
+    memcard_op_vblank = VSync(-1);
+}
+
+static void memcard_op_end(int status)
+{
+    if (memcard_op_name && status <= 0)
+    {
+        printf("MEMCARD %s %s in %d vblanks\n", memcard_op_name,
+               (status == 0) ? "done" : "failed", VSync(-1) - memcard_op_vblank);
+        memcard_op_name = NULL;
+    }
+}
+#endif
+
 static inline void memcard_access_wait(void)
 {
     printf("[R]");
@@ -264,6 +289,13 @@ int memcard_check(int port)
     int sw_card_op;
     int hw_card_op;
 
+#ifdef DEV_EXE
+    if (memcard_host)
+    {
+        return memcard_host_check(port);
+    }
+#endif
+
     chan = port * 16;
     retries = 0;
 
@@ -382,6 +414,13 @@ void memcard_init(void)
     if (!memcard_initialized)
     {
         memcard_initialized = !memcard_initialized;
+#ifdef DEV_EXE
+        if (memcard_host)
+        {
+            memcard_host_init();
+            return;
+        }
+#endif
         gHwCardLastOp = 1;
 
         gSwCardLastOp = 1;
@@ -450,6 +489,14 @@ void memcard_init(void)
 
 void memcard_exit(void)
 {
+#ifdef DEV_EXE
+    if (memcard_host)
+    {
+        memcard_host_exit();
+        memcard_initialized = FALSE;
+        return;
+    }
+#endif
     StopCARD();
     EnterCriticalSection();
     CloseEvent(gHardware_end_io);
@@ -470,6 +517,14 @@ void memcard_retry(int port)
     int count;
     int i;
 
+#ifdef DEV_EXE
+    // memcard_host_check has already set last_op
+    if (memcard_host)
+    {
+        return;
+    }
+#endif
+
     switch (gMemCards[port].last_op)
     {
     case 1:
@@ -530,6 +585,13 @@ MEM_CARD *memcard_get_files(int port)
     MEM_CARD *pCardBase = gMemCards;
     MEM_CARD *pCard = &pCardBase[port];
 
+#ifdef DEV_EXE
+    if (memcard_host)
+    {
+        return memcard_host_get_files(port);
+    }
+#endif
+
     if (pCard->last_op == 1 || pCard->last_op == 4)
     {
         memcard_load_files(port);
@@ -554,6 +616,13 @@ int memcard_delete(int port, const char *filename)
     MEM_CARD *pCardBase = gMemCards;
     MEM_CARD *pCard = &pCardBase[port];
 
+#ifdef DEV_EXE
+    if (memcard_host)
+    {
+        return memcard_host_delete(port, filename);
+    }
+#endif
+
     if (pCard->last_op == 1)
     {
         sprintf(tmp, "bu%02X:%s", 16 * port, filename);
@@ -612,6 +681,15 @@ void memcard_write(int port, const char *filename, int offset, char *buffer, int
     int fd;
     char name[32];
 
+#ifdef DEV_EXE
+    memcard_op_start("WRITE");
+    if (memcard_host)
+    {
+        memcard_host_write(port, filename, offset, buffer, size);
+        return;
+    }
+#endif
+
     sprintf(name, "bu%02X:%s", port * 16, filename);
 
     fd = open(name, (blocks << 16) | O_CREAT);
@@ -646,6 +724,15 @@ void memcard_read(int port, const char *filename, int offset, char *buffer, int
     char name[32];
     int fd;
 
+#ifdef DEV_EXE
+    memcard_op_start("READ");
+    if (memcard_host)
+    {
+        memcard_host_read(port, filename, offset, buffer, size);
+        return;
+    }
+#endif
+
     sprintf(name, "bu%02x:%s", port * 16, filename);
     fd = open(name, FREAD | FASYNC);
     if (fd < 0)
@@ -668,7 +755,15 @@ void memcard_read(int port, const char *filename, int offset, char *buffer, int
 
 int memcard_get_status(void)
 {
+#ifdef DEV_EXE
+    int status;
+
+    status = memcard_host ? memcard_host_get_status() : gMemCard_io_size;
+    memcard_op_end(status);
+    return status;
+#else
     return gMemCard_io_size;
+#endif
 }
 
 /**
@@ -684,6 +779,13 @@ int memcard_format(int port)
     int  retries;
     char cardPath[32];
 
+#ifdef DEV_EXE
+    if (memcard_host)
+    {
+        return memcard_host_format(port);
+    }
+#endif
+
     retries = 4;
     sprintf(cardPath, "bu%02x:", port * 16);
 
@@ -37,4 +37,22 @@ void memcard_read(int port, const char *filename, int offset, char *buffer, int
 int  memcard_get_status(void);
 int  memcard_format(int port);
 
+#ifdef DEV_EXE
+/* contrib/dev/memcard_host.c */
+extern int  memcard_host;
+extern int  memcard_host_rate;
+extern int  memcard_host_fail;
+extern char memcard_host_file[2][16];
+
+void memcard_host_init(void);
+void memcard_host_exit(void);
+int  memcard_host_check(int port);
+MEM_CARD *memcard_host_get_files(int port);
+int  memcard_host_delete(int port, const char *filename);
+void memcard_host_write(int port, const char *filename, int offset, char *buffer, int size);
+void memcard_host_read(int port, const char *filename, int offset, char *buffer, int size);
+int  memcard_host_get_status(void);
+int  memcard_host_format(int port);
+#endif
+
 #endif // __MGS_MEMCARD_H__
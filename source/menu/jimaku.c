@@ -132,6 +132,10 @@ STATIC void menu_jimaku_init_helper(KCB *kcb)
     font_set_buffer(kcb, MENU_JimakuTextBody);
     font_set_color(kcb, 0, 0x6739, 0);
     font_clut_update(kcb);
+#ifdef DEV_EXE
+    font_keep_lines(kcb, GV_AllocResidentMemory(MENU_JIMAKU_LINES * font_get_buffer_size(kcb)),
+                    MENU_JIMAKU_LINES);
+#endif
 }
 
 void menu_jimaku_init(MenuWork *work)
@@ -155,6 +159,14 @@ void MENU_JimakuWrite(char *str, int frames)
     }
 }
 
+#ifdef DEV_EXE
+/* Lays out a subtitle ahead of time, so writing it later only copies it */
+void MENU_JimakuLayout(char *str)
+{
+    font_layout_string(&gUnkJimakuStruct_800BDA70.field_C_font, str);
+}
+#endif
+
 void MENU_JimakuClear(void)
 {
     gUnkJimakuStruct_800BDA70.field_0_active = 0;
@@ -610,6 +610,12 @@ void MENU_AreaNameWrite(char *areaName);
 void NewJimakuStr(char *str, int int_1);
 void NewJimaku(void);
 
+#ifdef DEV_EXE
+#define MENU_JIMAKU_LINES   4   // subtitles kept laid out
+
+void MENU_JimakuLayout(char *str);
+#endif
+
 /* radiotable.c */
 void MENU_InitRadioTable(void);
 void MENU_ClearRadioTable(void);
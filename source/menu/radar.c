@@ -212,6 +212,173 @@ extern int              gControlCount_800AB9B4;
 
 #define RGB(r, g, b) ((r) | (g << 8) | (b << 16))
 
+#ifdef DEV_EXE
+/*
+ * The walls of the active area groups, scaled to radar coordinates once per
+ * map, group mask and radar scale. Each frame only the player's offset is
+ * subtracted, instead of passing every wall through the scratchpad and the
+ * GTE. The culling and the level test still run every frame, on the same
+ * walls in the same order, so the lines drawn are the same.
+ * Dynamic segments move, so they are not cached.
+ */
+#define RADAR_WALLS 1024
+
+typedef struct RADAR_WALL
+{
+    HZD_SEG *wall;
+    char    *flags;     // wallsFlags entry, skip the wall if 0x80
+    char    *flags2;    // second flags array, 0x80 draws the wall in red
+    short    x0, y0;
+    short    x1, y1;
+} RADAR_WALL;
+
+int MENU_RadarWallCache = 1;
+
+STATIC RADAR_WALL radar_walls[RADAR_WALLS];
+STATIC int        radar_wall_count;
+STATIC HZD_HDL   *radar_wall_hzd;
+STATIC int        radar_wall_handlers;  // HZD_Handlers, as the heap reuses handler addresses
+STATIC int        radar_wall_groups;
+STATIC short      radar_wall_scale[4];
+
+/* Returns 0 if the active groups have more walls than the cache holds */
+static int radar_cache_walls(HZD_HDL *hzd, int area_bits)
+{
+    MATRIX     *scale;
+    HZD_GRP    *group;
+    HZD_SEG    *wall;
+    RADAR_WALL *entry;
+    int         g, n;
+
+    scale = &gRadarScaleMatrix_800BD580;
+
+    if (hzd == radar_wall_hzd && HZD_Handlers == radar_wall_handlers && area_bits == radar_wall_groups &&
+        scale->m[0][0] == radar_wall_scale[0] && scale->m[0][1] == radar_wall_scale[1] &&
+        scale->m[1][0] == radar_wall_scale[2] && scale->m[1][1] == radar_wall_scale[3])
+    {
+        return radar_wall_count >= 0;
+    }
+
+    radar_wall_hzd = hzd;
+    radar_wall_handlers = HZD_Handlers;
+    radar_wall_groups = area_bits;
+    radar_wall_scale[0] = scale->m[0][0];
+    radar_wall_scale[1] = scale->m[0][1];
+    radar_wall_scale[2] = scale->m[1][0];
+    radar_wall_scale[3] = scale->m[1][1];
+
+    entry = radar_walls;
+
+    // highest group first, as drawMap_800391D0 walks them
+    for (g = hzd->header->n_groups - 1; g >= 0; g--)
+    {
+        if (!(area_bits & (1 << g)))
+        {
+            continue;
+        }
+
+        group = &hzd->header->groups[g];
+
+        if (entry + group->n_walls > &radar_walls[RADAR_WALLS])
+        {
+            radar_wall_count = -1;
+            return 0;
+        }
+
+        wall = group->walls;
+        for (n = 0; n < group->n_walls; n++, wall++, entry++)
+        {
+            entry->wall = wall;
+            entry->flags = group->wallsFlags + n;
+            entry->flags2 = group->wallsFlags + group->n_walls + n;
+
+            // what gte_rt gives for the (x, z) pair, without the translation
+            entry->x0 = (scale->m[0][0] * wall->p1.x + scale->m[0][1] * wall->p1.z) >> 12;
+            entry->y0 = (scale->m[1][0] * wall->p1.x + scale->m[1][1] * wall->p1.z) >> 12;
+            entry->x1 = (scale->m[0][0] * wall->p2.x + scale->m[0][1] * wall->p2.z) >> 12;
+            entry->y1 = (scale->m[1][0] * wall->p2.x + scale->m[1][1] * wall->p2.z) >> 12;
+        }
+    }
+
+    radar_wall_count = entry - radar_walls;
+    return 1;
+}
+
+/* The cached form of the static wall loop in drawMap_800391D0 */
+static LINE_F2 *radar_draw_walls(LINE_F2 *pLine, void *pLimit, unsigned char *ot, int *prim,
+                                 DG_PVECTOR *pvec, int xoff, int zoff)
+{
+    RADAR_WALL *entry;
+    HZD_SEG    *wall;
+    int        *ot2;
+    int         rgb;
+    int         zmin, zmax;
+    int         n;
+
+    entry = radar_walls;
+    for (n = radar_wall_count; n > 0; n--, entry++)
+    {
+        if (*entry->flags & 0x80)
+        {
+            continue;
+        }
+
+        wall = entry->wall;
+
+        if (wall->p1.x > pvec[1].vz || pvec[1].vxy > wall->p2.x)
+        {
+            continue;
+        }
+
+        if (wall->p1.z > wall->p2.z)
+        {
+            zmin = wall->p2.z;
+            zmax = wall->p1.z;
+        }
+        else
+        {
+            zmin = wall->p1.z;
+            zmax = wall->p2.z;
+        }
+
+        if (pvec[2].vz < zmin || zmax < pvec[2].vxy)
+        {
+            continue;
+        }
+
+        if (((pvec[3].vxy < wall->p1.y) || ((wall->p1.y + wall->p1.h) < pvec[3].vz)) &&
+            ((pvec[3].vxy < wall->p2.y) || ((wall->p2.y + wall->p2.h) < pvec[3].vz)))
+        {
+            rgb = 0x40004000;
+            ot2 = (int *)ot;
+        }
+        else
+        {
+            rgb = (*entry->flags2 & 0x80) ? 0x404020B4 : 0x4048A000;
+            ot2 = prim;
+        }
+
+        pLine->x0 = entry->x0 - xoff;
+        pLine->y0 = entry->y0 - zoff;
+        pLine->x1 = entry->x1 - xoff;
+        pLine->y1 = entry->y1 - zoff;
+
+        LSTORE(rgb, &pLine->r0);
+        pLine->tag = *ot2 | 0x03000000;
+        *ot2 = (int)(pLine)&0xffffff;
+
+        pLine++;
+
+        if ((void *)pLine > pLimit)
+        {
+            break;
+        }
+    }
+
+    return pLine;
+}
+#endif
+
 // Couldn't test it, but it should be the appropriate function name.
 void drawMap_800391D0(MenuWork *work, unsigned char *ot, int arg2)
 {
@@ -444,6 +611,18 @@ void drawMap_800391D0(MenuWork *work, unsigned char *ot, int arg2)
 
     for (i = 0; i < 2; i++)
     {
+#ifdef DEV_EXE
+        if (i == 0 && MENU_RadarWallCache && radar_cache_walls(pMap->hzd, HZD_CurrentGroup))
+        {
+            pLine = radar_draw_walls(pLine, pLimit, ot, prim, pvec, xoff, zoff);
+            if ((void *)pLine > pLimit)
+            {
+                goto end;
+            }
+            continue;
+        }
+#endif
+
         pHzdMap = NULL;
         pWallDst = getScratchAddr2(int, 0x20);
         pWallDst2 = getScratchAddr2(int, 0x24);
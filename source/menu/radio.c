@@ -15,6 +15,9 @@
 #include "game/game.h"
 #include "linkvar.h"
 #include "sd/g_sound.h"
+#ifdef DEV_EXE
+#include <libapi.h>     // for GetRCnt
+#endif
 
 int                       SECTION(".sbss") dword_800ABAF8;
 int                       SECTION(".sbss") gRadioClut_800ABAFC;
@@ -737,6 +740,13 @@ void menu_radio_codec_helper_helper14_80040DC4(MenuWork *work, int param_2)
 
 STATIC RECT RADIO_MES_VRAM_POS_800AB630 = {960, 260, 63, 76};
 
+#ifdef DEV_EXE
+// the choice list last drawn into the message board, see helper12
+STATIC unsigned char *radio_list_script;
+STATIC int            radio_list_index;
+STATIC KCB           *radio_list_kcb;
+#endif
+
 void init_radio_message_board_80040F74(MenuWork *work)
 {
     KCB  local_kcb;
@@ -762,6 +772,9 @@ void init_radio_message_board_80040F74(MenuWork *work)
 
         work->field_214_font = allocated_kcb;
         memcpy(allocated_kcb, ptr_local_kcb, sizeof(KCB));
+#ifdef DEV_EXE
+        radio_list_script = NULL;
+#endif
 
         dword_800ABB04 = NULL;
     }
@@ -770,6 +783,9 @@ void init_radio_message_board_80040F74(MenuWork *work)
 void menu_radio_codec_helper__helper13_800410E4(MenuWork *work, char *string)
 {
     KCB *kcb = work->field_214_font;
+#ifdef DEV_EXE
+    radio_list_script = NULL;
+#endif
     dword_800ABB04 = string;
     font_print_string(kcb, string);
     font_update(kcb);
@@ -778,6 +794,9 @@ void menu_radio_codec_helper__helper13_800410E4(MenuWork *work, char *string)
 void sub_80041118(MenuWork *work)
 {
     KCB *kcb = work->field_214_font;
+#ifdef DEV_EXE
+    radio_list_script = NULL;
+#endif
     dword_800ABB04 = NULL;
     font_clear(kcb);
     font_update(kcb);
@@ -817,6 +836,10 @@ void sub_8004124C(MenuWork *work)
     GV_FreeMemory(GV_PACKET_MEMORY0, work->field_214_font);
     work->field_214_font = NULL;
     dword_800ABB04 = NULL;
+#ifdef DEV_EXE
+    radio_list_script = NULL;
+    font_print_stats("codec");
+#endif
 }
 
 // nop count was incorrect to this point
@@ -834,6 +857,9 @@ int menu_radio_codec_helper_helper12_80041280(MenuWork *work, unsigned char *pOt
     int                ypos;
     int                color;
     char              *string;
+#ifdef DEV_EXE
+    long               intime;
+#endif
 
     pMenuChara = work->field_218;
     kcb = work->field_214_font;
@@ -851,6 +877,19 @@ int menu_radio_codec_helper_helper12_80041280(MenuWork *work, unsigned char *pOt
         pMenuChara->field_1A_index++;
     }
 
+#ifdef DEV_EXE
+    // the board still holds this list with this choice picked, and nothing
+    // else (the memory list, the save menu) has cleared or drawn over it
+    if (pMenuChara->field_C_pScript == radio_list_script &&
+        pMenuChara->field_1A_index == radio_list_index && kcb == radio_list_kcb &&
+        font_buffer_kept(kcb->font_buffer))
+    {
+        goto check_choice;
+    }
+
+    intime = GetRCnt(RCntCNT1);
+#endif
+
     var_s7 = 0;
     var_s2 = 0;
     index = 0;
@@ -893,6 +932,11 @@ int menu_radio_codec_helper_helper12_80041280(MenuWork *work, unsigned char *pOt
         index++;
     }
 
+#ifdef DEV_EXE
+    font_layout_hsyncs += (GetRCnt(RCntCNT1) - intime) & 0xffff;
+    font_layout_count++;
+#endif
+
     if (last_index != pMenuChara->field_1A_index)
     {
         GM_SeSet2(0, 63, SE_MENU_CURSOR);
@@ -902,6 +946,14 @@ int menu_radio_codec_helper_helper12_80041280(MenuWork *work, unsigned char *pOt
 
     kcb->max_width = var_s7;
 
+#ifdef DEV_EXE
+    radio_list_script = pMenuChara->field_C_pScript;
+    radio_list_index = pMenuChara->field_1A_index;
+    radio_list_kcb = kcb;
+    font_keep_buffer(kcb->font_buffer);
+
+check_choice:
+#endif
     if (pPad->press & PAD_CIRCLE)
     {
         GM_LastResultFlag = pMenuChara->field_1A_index;
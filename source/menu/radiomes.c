@@ -451,6 +451,13 @@ void menu_radio_codec_task_proc_80047AA0()
     fontAddrOffset = load_big_endian_short_2(radioDatIter + 1) + 1;
     font_set_font_addr(1, radioDatIter + fontAddrOffset);
 
+#ifdef DEV_EXE
+    if (font_bench_request)
+    {
+        font_bench_radio((unsigned char *)radioDatIter);
+    }
+#endif
+
     dword_800ABB38->field_0_state = 0;
     menu_gcl_exec_block_800478B4(dword_800ABB38, radioDatIter);
     dword_800ABB38->field_0_state = 2;
@@ -116,6 +116,10 @@ extern int mts_wait_vbl( long count );
 
 extern /*unsigned*/ int mts_get_tick_count( void );
 
+#ifdef DEV_EXE
+extern int mts_vsync_rate;  /* virtual vblanks per vblank, 8.8 fixed point */
+#endif
+
 /* malloc */
 
 /*
@@ -58,6 +58,79 @@ STATIC MTS_ITASK mts_itask_chain = { NULL, 0, -1, 0, NULL };
 STATIC int       mts_unused_event_descriptor = 0;
 STATIC int       mts_boot_stack_size = 0;
 
+#ifdef DEV_EXE
+// Virtual vblanks per real vblank in 8.8 fixed point, e.g. 0x80 runs every
+// mts_wait_vbl() paced task at half speed.
+int              mts_vsync_rate = 0x100;
+STATIC int       mts_vsync_real = -1;
+STATIC int       mts_vsync_frac = 0;
+
+STATIC MTS_TASK_STAT mts_task_stat[ MTS_NR_TASK ];
+STATIC long          mts_switch_time = 0;
+
+// Earliest target in mts_itask_chain, so most vblanks skip the walk
+STATIC unsigned int  mts_itask_due = -1;
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+#ifdef DEV_EXE
+static inline void mts_reset_task_stat( int tasknr )
+{
+    MTS_TASK_STAT *stat;
+
+    stat = &mts_task_stat[ tasknr ];
+    stat->cpu = 0;
+    stat->wait = 0;
+    stat->switches = 0;
+    stat->overruns = 0;
+    stat->out_time = mts_time;
+    stat->blocked = 0;
+}
+
+// Charges the elapsed hsyncs to the task being switched out and the
+// blocked time to the task being switched in. Interrupts are disabled.
+static inline void mts_account_switch( int from, int to )
+{
+    long           now;
+    MTS_TASK_STAT *stat;
+
+    now = GetRCnt( RCntCNT1 );
+
+    if ( from >= 0 )
+    {
+        stat = &mts_task_stat[ from ];
+        stat->cpu += ( now - mts_switch_time ) & 0xffff;
+        stat->out_time = mts_time;
+        stat->blocked = mts_tasks_800C0C30[ from ].state != MTS_TASK_READY;
+    }
+
+    stat = &mts_task_stat[ to ];
+    if ( stat->blocked )
+    {
+        stat->wait += mts_time - stat->out_time;
+        stat->blocked = 0;
+    }
+    stat->switches++;
+
+    mts_switch_time = now;
+}
+
+static inline int mts_virtual_vsync( void )
+{
+    int real;
+
+    real = VSync( -1 );
+    mts_vsync_frac += ( real - mts_vsync_real ) * mts_vsync_rate;
+    mts_vsync_real = real;
+
+    mts_time += mts_vsync_frac >> 8;
+    mts_vsync_frac &= 0xff;
+
+    return mts_time;
+}
+#endif
+
 /*---------------------------------------------------------------------------*/
 
 static inline void task_start_body( void )
@@ -151,6 +224,9 @@ static inline void mts_TransferExecution( int task )
     else
     {
         change = 1;
+#ifdef DEV_EXE
+        mts_account_switch( mts_active_task_800C0DB0, task );
+#endif
         mts_active_task_800C0DB0 = task;
     }
 
@@ -172,6 +248,9 @@ static inline void mts_TransferExecutionWithinInterrupt( int task )
     }
     else
     {
+#ifdef DEV_EXE
+        mts_account_switch( mts_active_task_800C0DB0, task );
+#endif
         mts_active_task_800C0DB0 = task;
         change = 1;
     }
@@ -246,14 +325,27 @@ void mts_VSyncCallback( void )
     MTS_ITASK *iter;
     MTS_ITASK *chain;
 
+#ifdef DEV_EXE
+    mts_virtual_vsync();
+#else
     // get time from boot (libref.pdf page 348)
     mts_time = VSync( -1 );
+#endif
 
     if ( mts_controller_callback )
     {
         mts_controller_callback();
     }
 
+#ifdef DEV_EXE
+    if ( mts_time < mts_itask_due )
+    {
+        return;
+    }
+
+    mts_itask_due = -1;
+#endif
+
     tasknr = -1;
     iter = mts_itask_chain.next;
     chain = &mts_itask_chain;
@@ -263,6 +355,12 @@ void mts_VSyncCallback( void )
         // check if the deadline is reached
         if ( mts_time < iter->target )
         {
+#ifdef DEV_EXE
+            if ( iter->target < mts_itask_due )
+            {
+                mts_itask_due = iter->target;
+            }
+#endif
             chain = iter;
             continue;
         }
@@ -284,6 +382,10 @@ void mts_VSyncCallback( void )
         }
         else
         {
+#ifdef DEV_EXE
+            // the callback declined, poll it again next vblank
+            mts_itask_due = iter->target;
+#endif
             chain = iter;
         }
     }
@@ -301,6 +403,9 @@ void mts_init_vsync( void )
     if ( mts_time == -1 )
     {
         mts_time = VSync( -1 );
+#ifdef DEV_EXE
+        mts_vsync_real = mts_time;
+#endif
         VSyncCallback( mts_VSyncCallback );
     }
 }
@@ -348,6 +453,13 @@ int mts_wait_vbl( long count )
             D_800C0C04 = chain;
         }
 
+#ifdef DEV_EXE
+        if ( intr->target < mts_itask_due )
+        {
+            mts_itask_due = intr->target;
+        }
+#endif
+
         mts_tasks_800C0C30[ mts_active_task_800C0DB0 ].state = MTS_TASK_WAIT_VBL;
         mts_ready_tasks_800C0DB4 &= ~( 1 << mts_active_task_800C0DB0 );
 
@@ -398,6 +510,9 @@ static inline void mts_CreateTask( int tasknr, void *stackend, void *entrypoint
     mts_ready_tasks_800C0DB4 |= 1 << tasknr;
 
     task->overrun = 0;
+#ifdef DEV_EXE
+    mts_reset_task_stat( tasknr );
+#endif
 
     SwExitCriticalSection();
 }
@@ -514,6 +629,9 @@ int mts_isend( int dst )
     else
     {
         to->overrun++;
+#ifdef DEV_EXE
+        mts_task_stat[ dst ].overruns++;
+#endif
         return 0;
     }
 
@@ -1034,6 +1152,9 @@ void mts_SystemTaskEntrypoint( void )
                 mts_ready_tasks_800C0DB4 |= 1 << tasknr;
 
                 task->overrun = 0;
+#ifdef DEV_EXE
+                mts_reset_task_stat( tasknr );
+#endif
 
                 SwExitCriticalSection();
 
@@ -1340,6 +1461,27 @@ void mts_print_process_status( void )
     }
 
     cprintf( "Tick count %d\n\n", mts_time );
+
+#ifdef DEV_EXE
+    // cprintf is a stub, so the accounting goes to printf
+    printf( "Task   CPU(hsync) Wait(vbl) Switch Overrun\n" );
+
+    for ( i = 0; i < MTS_NR_TASK; i++ )
+    {
+        if ( mts_tasks_800C0C30[ i ].state == MTS_TASK_DEAD )
+        {
+            continue;
+        }
+
+        printf( "%02d   %10u %9u %6u %7u\n", i,
+                mts_task_stat[ i ].cpu,
+                mts_task_stat[ i ].wait,
+                mts_task_stat[ i ].switches,
+                mts_task_stat[ i ].overruns );
+    }
+
+    printf( "VSync rate %d.%02d\n", mts_vsync_rate >> 8, ( ( mts_vsync_rate & 0xff ) * 100 ) >> 8 );
+#endif
 }
 
 /*---------------------------------------------------------------------------*/
@@ -50,6 +50,18 @@ typedef struct MTS_TASK
     struct TCB *tcb;             // Thread Control Block pointer
 } MTS_TASK;
 
+#ifdef DEV_EXE
+typedef struct MTS_TASK_STAT
+{
+    unsigned int cpu;           // hsyncs (RCntCNT1) spent running
+    unsigned int wait;          // vblanks spent blocked (not ready)
+    unsigned int switches;      // number of times switched in
+    unsigned int overruns;      // total interrupts lost, see MTS_TASK.overrun
+    int          out_time;      // mts_time when last switched out
+    int          blocked;       // switched out in a non-ready state
+} MTS_TASK_STAT;
+#endif
+
 #define MTS_STACK_COOKIE 0x12435687
 
 /*---------------------------------------------------------------------------*/
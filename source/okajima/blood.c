@@ -30,6 +30,16 @@ typedef struct _BloodWork
 
 /*---------------------------------------------------------------------------*/
 
+#ifdef DEV_EXE
+STATIC BloodWork blood_pool_buf[16];
+STATIC GV_POOL   blood_pool = GV_POOL_INIT(blood_pool_buf);
+
+STATIC void blood_Free(void *work)
+{
+    GV_FreePoolActor(&blood_pool, work);
+}
+#endif
+
 STATIC RECT rect_8009F60C = {50, 50, 100, 100};
 
 STATIC void blood_loader2_helper2_80072080(MATRIX *pMtx, SVECTOR *arg1, SVECTOR *arg2, int count, int arg4)
@@ -298,7 +308,11 @@ void *NewBlood(MATRIX *arg0, int count)
 
     for (i = 0; i < count; i++)
     {
+#ifdef DEV_EXE
+        work = GV_NewPoolActor(&blood_pool, EXEC_LEVEL, sizeof(BloodWork), blood_Free);
+#else
         work = GV_NewActor(EXEC_LEVEL, sizeof(BloodWork));
+#endif
 
         if (!work)
         {
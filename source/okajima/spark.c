@@ -29,6 +29,17 @@ typedef struct SparkWork
 
 /*---------------------------------------------------------------------------*/
 
+#ifdef DEV_EXE
+// a burst of sparks is count + 1 actors that live for 12 frames
+STATIC SparkWork spark_pool_buf[24];
+STATIC GV_POOL   spark_pool = GV_POOL_INIT(spark_pool_buf);
+
+STATIC void spark_Free(void *work)
+{
+    GV_FreePoolActor(&spark_pool, work);
+}
+#endif
+
 STATIC int gSparkRandomTableIndex = -1;
 STATIC int gSparkRandomTableIndex2 = 0;
 
@@ -303,7 +314,11 @@ void *NewSpark(MATRIX *pMatrix, int count)
 
     for (i = 0; i <= count; i++)
     {
+#ifdef DEV_EXE
+        work = GV_NewPoolActor(&spark_pool, EXEC_LEVEL, sizeof(SparkWork), spark_Free);
+#else
         work = GV_NewActor(EXEC_LEVEL, sizeof(SparkWork));
+#endif
         if (work != NULL)
         {
             GV_SetNamedActor(&work->actor, spark_Act, spark_Die, "spark.c");
@@ -87,14 +87,18 @@ static void Die(Work *work)
 
 static int GetResources(Work *work, int name, int where)
 {
+#ifndef DEV_EXE
     CONTROL       **whereListIter;
+#endif
     CONTROL        *control;
     OBJECT         *parent_obj;
     OBJECT_NO_ROTS *obj;
     int             name_opt;
     int             model;
     int             num_parent;
+#ifndef DEV_EXE
     int             i;
+#endif
 
     model = GCL_StrToInt(GCL_GetOption('m'));
     num_parent = work->field_4C = GCL_StrToInt(GCL_GetOption('u'));
@@ -102,6 +106,15 @@ static int GetResources(Work *work, int name, int where)
     work->control = NULL;
     work->field_24 = NULL;
 
+#ifdef DEV_EXE
+    parent_obj = NULL;
+    control = GM_WhereFind(name_opt);
+    if (control)
+    {
+        work->control = control;
+        parent_obj = work->field_24 = (OBJECT *)(control + 1);
+    }
+#else
     whereListIter = GM_WhereList;
     parent_obj = NULL;
     for (i = gControlCount_800AB9B4 - 1; i >= 0; i--)
@@ -115,6 +128,7 @@ static int GetResources(Work *work, int name, int where)
             break;
         }
     }
+#endif
     obj = &work->field_28;
     if (work->control == NULL)
     {
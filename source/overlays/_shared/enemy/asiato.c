@@ -237,6 +237,65 @@ int NearAsiato_800D13A0()
 }
 
 
+#ifdef DEV_EXE
+HZD_RAY SECTION("overlay.bss") AsiatoRays[48];
+char    SECTION("overlay.bss") AsiatoRayIndex[48];
+int     SECTION("overlay.bss") AsiatoRayLength[48];
+
+// Same result as below, with the footprints in the vision cone checked in one batch
+int SearchNearAsiato_800D13B0(HZD_HDL* hzd, SVECTOR* mov, int facedir, int vision_unk, int length )
+{
+    int i;
+    int n;
+    int len;
+    int max_len;
+    SVECTOR svec;
+
+    int s4;
+    max_len = 100000000;
+
+    n = 0;
+    for ( i = 0; i < 48 ; i++ )
+    {
+        if (AsiatoPositions[i].pad == 1 )
+        {
+            GV_SubVec3( &AsiatoPositions[i], mov, &svec );
+            svec.vy = 0;
+            len = GV_VecLen3( &svec );
+
+            if ( len < length && GV_DiffDirAbs( facedir, GV_VecDir2(&svec) ) < vision_unk )
+            {
+                AsiatoRays[n].from = *mov;
+                AsiatoRays[n].to = AsiatoPositions[i];
+                AsiatoRayIndex[n] = i;
+                AsiatoRayLength[n] = len;
+                n++;
+            }
+        }
+    }
+
+    HZD_LineCheckBatch( hzd, AsiatoRays, n, HZD_CHECK_ALL, SEGMENT_ATR );
+
+    s4 = 0;
+    for ( i = 0; i < n ; i++ )
+    {
+        if ( AsiatoRayLength[i] < max_len && !AsiatoRays[i].hit )
+        {
+            max_len = AsiatoRayLength[i];
+            s4 = AsiatoRayIndex[i];
+        }
+    }
+
+    if ( max_len == 100000000 )
+    {
+        NearAsiato = -1;
+        return -1;
+    }
+
+    NearAsiato = s4;
+    return s4;
+}
+#else
 int SearchNearAsiato_800D13B0(HZD_HDL* hzd, SVECTOR* mov, int facedir, int vision_unk, int length )
 {
     int i;
@@ -274,6 +333,7 @@ int SearchNearAsiato_800D13B0(HZD_HDL* hzd, SVECTOR* mov, int facedir, int visio
     NearAsiato = s4;
     return s4;
 }
+#endif
 
 int s00a_asiato_800D1500( HZD_HDL *hzd, SVECTOR *pos, int name )
 {
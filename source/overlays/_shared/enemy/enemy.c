@@ -358,7 +358,12 @@ void EnemyActionMain_800CA07C( WatcherWork *work )
         s00a_command_800C9E68(work);
         s00a_command_800C9D28(work);
         s00a_command_800C9D7C(work);
+#ifdef DEV_EXE
+        AI_BenchThink( work, work->think1, work->think2,
+                       (void (*)( void * ))Enemy_Think_800CE99C );
+#else
         Enemy_Think_800CE99C(work);
+#endif
         ENE_ExecPutChar_800C9818(work);
     }
 
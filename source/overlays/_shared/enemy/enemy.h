@@ -795,4 +795,9 @@ void s00a_command_800CEB54();
 
 int  DirectTrace_800CC154( WatcherWork *work, int val );
 
+#ifdef DEV_EXE
+/* contrib/dev/ai_bench.c */
+void AI_BenchThink( void *work, int think1, int think2, void (*think)( void * ) );
+#endif
+
 #endif // __MGS_ENEMY_H__
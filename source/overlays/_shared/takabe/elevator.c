@@ -105,8 +105,10 @@ void ElevatorAct_800D8EA8(ElevatorWork *work)
     int            found;
     int            message;
     int            scale;
+#ifndef DEV_EXE
     CONTROL      **where;
     int            n_controls;
+#endif
     CONTROL       *control;
     HITTABLE *bomb;
     int            i, j;
@@ -288,6 +290,13 @@ void ElevatorAct_800D8EA8(ElevatorWork *work)
 
         if (work->f58C & 0x4)
         {
+#ifdef DEV_EXE
+            control = GM_WhereFind(work->f594);
+            if (control)
+            {
+                GV_AddVec3(&control->mov, &sp10, &control->mov);
+            }
+#else
             where = GM_WhereList;
             for (n_controls = gControlCount_800AB9B4; n_controls > 0; n_controls--)
             {
@@ -300,6 +309,7 @@ void ElevatorAct_800D8EA8(ElevatorWork *work)
 
                 where++;
             }
+#endif
         }
         // translate the position of the c4 actors if they are on the elevator
         if (bakudan_count_8009F42C != 0)
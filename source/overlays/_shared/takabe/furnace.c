@@ -88,7 +88,11 @@ static void Act(Work *work)
         GM_GameOver();
     }
 
+#ifdef DEV_EXE
+    for (i = GM_WhereInBox(&work->bound[0], &work->bound[1], &wherelist); i > 0; i--, wherelist++)
+#else
     for (wherelist = GM_WhereList, i = gControlCount_800AB9B4; i > 0; i--, wherelist++)
+#endif
     {
         if (((*wherelist)->map->index & work->where) &&
             !((*wherelist)->skip_flag & CTRL_SKIP_TRAP) && (*wherelist)->name >= 64)
@@ -411,13 +411,25 @@ void *NewMirror_800E085C(int name, int where)
 
 void Mirror_800E08F0(MirrorWork *work, int name)
 {
+#ifndef DEV_EXE
     CONTROL    **where;
+#endif
     int          i;
     CONTROL     *control;
     MirrorEntry *entry;
     OBJECT      *object;
     DG_OBJ      *obj;
 
+#ifdef DEV_EXE
+    control = GM_WhereFind(name);
+    if (!control)
+    {
+        return;
+    }
+
+    entry = &work->entries[work->n_entries++];
+    entry->control = control;
+#else
     where = GM_WhereList;
     for (i = gControlCount_800AB9B4; i > 0; i--)
     {
@@ -437,6 +449,7 @@ void Mirror_800E08F0(MirrorWork *work, int name)
 
     entry = &work->entries[work->n_entries++];
     entry->control = *where;
+#endif
 
     object = (OBJECT *)(entry->control + 1); // why...
 
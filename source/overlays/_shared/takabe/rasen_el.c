@@ -92,8 +92,10 @@ void RasenElAct_800CC454(RasenElWork *work)
     int       f230;
     int       f224;
     int       elevation;
+#ifndef DEV_EXE
     CONTROL **where;
     int       i;
+#endif
     CONTROL  *control;
     int       height;
     int       y;
@@ -282,6 +284,13 @@ void RasenElAct_800CC454(RasenElWork *work)
 
     if ((work->f234 & 4) != 0)
     {
+#ifdef DEV_EXE
+        control = GM_WhereFind(work->f23C);
+        if (control)
+        {
+            control->mov.vy += height;
+        }
+#else
         where = GM_WhereList;
         for (i = gControlCount_800AB9B4; i > 0; i--)
         {
@@ -294,6 +303,7 @@ void RasenElAct_800CC454(RasenElWork *work)
 
             where++;
         }
+#endif
     }
 
     s11c_800CCFCC(work, elevation);
@@ -169,8 +169,12 @@ void s00a_rsurface_800D82E0(RSurfaceWork *work)
         return;
     }
 
+#ifdef DEV_EXE
+    i = GM_WhereInBox(&work->field_70, &work->field_68, &wherelistIter);
+#else
     wherelistIter = GM_WhereList;
     i = gControlCount_800AB9B4;
+#endif
     elemIter = &work->field_30[work->field_80];
 
     for (; i > 0; i--, wherelistIter++)
@@ -141,6 +141,14 @@ void no_cmd(void);
 /* sd_ioset.c */
 extern unsigned int freq_tbl[108];
 
+#ifdef DEV_EXE
+/* tracks with a pending spu_tr_wk change, consumed by spuwr() */
+extern unsigned long spu_tr_dirty;
+#define SD_SET_DIRTY(track)     (spu_tr_dirty |= 1 << (track))
+#else
+#define SD_SET_DIRTY(track)     ((void)0)
+#endif
+
 void spuwr(void);
 void sound_off(void);
 void sng_off(void);
@@ -179,6 +187,62 @@ extern unsigned long spu_ch_tbl[24+1];
 extern unsigned char blank_data[512];
 extern unsigned char dummy_data[4096];
 
+#ifdef DEV_EXE
+/* contrib/dev/sd_soft.c */
+#define SD_SOFT_VOICES  24
+
+enum {
+    SD_SOFT_OFF,
+    SD_SOFT_ATTACK,
+    SD_SOFT_DECAY,
+    SD_SOFT_SUSTAIN,
+    SD_SOFT_RELEASE
+};
+
+typedef struct SD_SOFT_VOICE
+{
+    unsigned short vol_l;
+    unsigned short vol_r;
+    unsigned short pitch;
+    unsigned long  addr;
+    long           a_mode;
+    long           s_mode;
+    long           r_mode;
+    unsigned short ar;
+    unsigned short dr;
+    unsigned short sr;
+    unsigned short sl;
+    unsigned short rr;
+    int            phase;
+    int            env;
+    unsigned long  samples;     /* source samples played since key on */
+} SD_SOFT_VOICE;
+
+extern SD_SOFT_VOICE sd_soft_voice[SD_SOFT_VOICES];
+extern int           sd_soft_spu;
+extern unsigned long sd_soft_keys;
+extern int           sd_soft_attr_writes;
+extern int           sd_soft_key_writes;
+extern int           sd_soft_ticks;
+extern int           sd_soft_voice_ticks;
+extern unsigned long sd_soft_sum;
+
+void sd_soft_set_voice_attr(SpuVoiceAttr *attr);
+void sd_soft_set_key(long on_off, unsigned long voice_bit);
+void sd_soft_tick(void);
+void sd_soft_dump(void);
+
+/* contrib/dev/sd_bench.c */
+#define SD_BENCH_SE     1
+#define SD_BENCH_SNG    2
+#define SD_BENCH_SPUWR  3
+
+extern int sd_bench_request;
+extern int sd_bench_song;
+
+void sd_bench_run_request(void);
+#endif
+
 /*---------------------------------------------------------------------------*/
 #ifndef __BSSDEFINE__
 
@@ -238,7 +238,11 @@ int StrFadeInt(void)
         attr.volume.right = diff;
     }
 
+#ifdef DEV_EXE
+    sd_soft_set_voice_attr(&attr);
+#else
     SpuSetVoiceAttr(&attr);
+#endif
 
     attr.mask = SPU_VOICE_VOLL | SPU_VOICE_VOLR;
     attr.voice = SPU_22CH;
@@ -259,7 +263,11 @@ int StrFadeInt(void)
         attr.volume.right = 0;
     }
 
+#ifdef DEV_EXE
+    sd_soft_set_voice_attr(&attr);
+#else
     SpuSetVoiceAttr(&attr);
+#endif
     return 0;
 }
 
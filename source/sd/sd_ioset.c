@@ -35,14 +35,25 @@ unsigned int freq_tbl[108] = {
     0x00D4, 0x00E1, 0x00EE, 0x00FC
 };
 
+#ifdef DEV_EXE
+unsigned long spu_tr_dirty;
+#endif
+
 void spuwr(void)
 {
     int          i;
     SpuVoiceAttr attr;
+#ifdef DEV_EXE
+    unsigned long dirty;
+#endif
 
     if (keyoffs)
     {
+#ifdef DEV_EXE
+        sd_soft_set_key(SPU_OFF, keyoffs);
+#else
         SpuSetKey(SPU_OFF, keyoffs);
+#endif
         keyoffs = 0;
     }
 
@@ -52,8 +63,21 @@ void spuwr(void)
         eoffs = 0;
     }
 
+#ifdef DEV_EXE
+    // only visit the tracks that vol_set/freq_set/tone_set/etc. touched
+    dirty = spu_tr_dirty & 0x1FFFFF;
+    spu_tr_dirty &= ~0x1FFFFF;
+
+    for (i = 0; dirty != 0; i++, dirty >>= 1)
+    {
+        if (!(dirty & 1))
+        {
+            continue;
+        }
+#else
     for (i = 0; i < 21; i++)
     {
+#endif
         attr.mask = 0;
         attr.voice = spu_ch_tbl[i + 1];
         if (spu_tr_wk[i].vol_fg)
@@ -106,7 +130,11 @@ void spuwr(void)
 
         if (attr.mask)
         {
+#ifdef DEV_EXE
+            sd_soft_set_voice_attr(&attr);
+#else
             SpuSetVoiceAttr(&attr);
+#endif
         }
     }
 
@@ -118,7 +146,11 @@ void spuwr(void)
 
     if (keyons)
     {
+#ifdef DEV_EXE
+        sd_soft_set_key(SPU_ON, keyons);
+#else
         SpuSetKey(SPU_ON, keyons);
+#endif
         keyons = 0;
     }
 }
@@ -132,6 +164,7 @@ void sound_off(void)
     {
         spu_tr_wk[i].rr = 7;
         spu_tr_wk[i].env3_fg = 1;
+        SD_SET_DIRTY(i);
 
         key_no = spu_ch_tbl[mtrack + 1];
         song_end |= key_no;
@@ -147,6 +180,7 @@ void sng_off(void)
     {
         spu_tr_wk[i].rr = 7;
         spu_tr_wk[i].env3_fg = 1;
+        SD_SET_DIRTY(i);
     }
     song_end |= 0x1FFFu;
     keyoffs |= 0x1FFFu;
@@ -156,6 +190,7 @@ void se_off(int i)
 {
     spu_tr_wk[i + 13].env3_fg = 1;
     spu_tr_wk[i + 13].rr = 0;
+    SD_SET_DIRTY(i + 13);
     song_end |= 1 << (i + 13);
     keyoffs |= 1 << (i + 13);
 }
@@ -244,6 +279,7 @@ void tone_set(unsigned char n)
 
     spu_tr_wk[mtrack].rr = sptr->rrd = ~voice_tbl[n].rr & 0x1F;
     spu_tr_wk[mtrack].env3_fg = 1;
+    SD_SET_DIRTY(mtrack);
     if (!sptr->panmod)
     {
         pan_set2(voice_tbl[n].pan);
@@ -293,12 +329,14 @@ void vol_set(unsigned int vol_data)
             spu_tr_wk[mtrack].vol_r = (vol_data * pant[pan] * sng_master_vol[mtrack]) >> 16;
             spu_tr_wk[mtrack].vol_l = (vol_data * pant[40 - pan] * sng_master_vol[mtrack]) >> 16;
             spu_tr_wk[mtrack].vol_fg = 1;
+            SD_SET_DIRTY(mtrack);
         }
         else
         {
             spu_tr_wk[mtrack].vol_r = vol_data * pant[pan];
             spu_tr_wk[mtrack].vol_l = vol_data * pant[40 - pan];
             spu_tr_wk[mtrack].vol_fg = 1;
+            SD_SET_DIRTY(mtrack);
         }
     }
     else
@@ -323,6 +361,7 @@ void vol_set(unsigned int vol_data)
         spu_tr_wk[mtrack].vol_r = vol_data * se_pant[pan];
         spu_tr_wk[mtrack].vol_l = vol_data * se_pant[64 - pan];
         spu_tr_wk[mtrack].vol_fg = 1;
+        SD_SET_DIRTY(mtrack);
     }
 }
 
@@ -351,6 +390,7 @@ void freq_set(unsigned int note_tune)
 
     spu_tr_wk[mtrack].pitch = freq;
     spu_tr_wk[mtrack].pitch_fg = 1;
+    SD_SET_DIRTY(mtrack);
 }
 
 void drum_set(unsigned char n)
@@ -124,6 +124,13 @@ void SdInt(void)
     {
         mts_receive(MTS_TASK_INTR, NULL);
         IntSdMain();
+#ifdef DEV_EXE
+        sd_soft_tick();
+        if (sd_bench_request)
+        {
+            sd_bench_run_request();
+        }
+#endif
         if (SpuIsTransferCompleted(SPU_TRANSFER_PEEK) == 1)
         {
             WaveSpuTrans();
@@ -219,7 +226,11 @@ void sd_init(void)
     sd_blank_attr.rr = 0;
     sd_blank_attr.sl = 15;
     sd_blank_attr.addr = blank_data_addr;
+#ifdef DEV_EXE
+    sd_soft_set_voice_attr(&sd_blank_attr);
+#else
     SpuSetVoiceAttr(&sd_blank_attr);
+#endif
     keyOn(SPU_23CH);
     c_attr.mask = SPU_COMMON_MVOLL | SPU_COMMON_MVOLR;
     c_attr.mvol.left = 0x3FFF;
@@ -230,13 +241,21 @@ void sd_init(void)
 void SdTerm(void)
 {
     SpuSetIRQCallback(NULL);
+#ifdef DEV_EXE
+    sd_soft_set_key(SPU_OFF, SPU_ALLCH);
+#else
     SpuSetKey(SPU_OFF, SPU_ALLCH);
+#endif
     SpuQuit();
 }
 
 void keyOff(unsigned int ch)
 {
+#ifdef DEV_EXE
+    sd_soft_set_key(SPU_OFF, ch);
+#else
     SpuSetKey(SPU_OFF, ch);
+#endif
 }
 
 void KeyOffStr(void)
@@ -250,7 +269,11 @@ void KeyOffStr(void)
 
     case SPU_ON:
     case SPU_ON_ENV_OFF:
+#ifdef DEV_EXE
+        sd_soft_set_key(SPU_OFF, SPU_21CH | SPU_22CH);
+#else
         SpuSetKey(SPU_OFF, SPU_21CH | SPU_22CH);
+#endif
         break;
 
     case SPU_OFF_ENV_ON:
@@ -289,7 +312,11 @@ void KeyOffStr2(void)
 
     case SPU_ON:
     case SPU_ON_ENV_OFF:
+#ifdef DEV_EXE
+        sd_soft_set_key(SPU_OFF, SPU_21CH | SPU_22CH);
+#else
         SpuSetKey(SPU_OFF, SPU_21CH | SPU_22CH);
+#endif
         break;
 
     case SPU_OFF_ENV_ON:
@@ -307,7 +334,11 @@ void KeyOffStr2(void)
 
 void keyOn(unsigned int ch)
 {
+#ifdef DEV_EXE
+    sd_soft_set_key(SPU_ON, ch);
+#else
     SpuSetKey(SPU_ON, ch);
+#endif
 }
 
 int sd_mem_alloc(void)
@@ -11,6 +11,23 @@
 int str_tick_count = -1;
 char *dword_8009F7B8 = 0;
 
+#ifdef DEV_EXE
+/*
+ * Latency budget and underrun accounting for the stream voices.
+ *
+ * str_preroll holds back the first transfer until that many stream
+ * blocks (type 1 packets) are waiting in the FS heap, trading start-up
+ * latency for headroom against CD stalls. 0 keeps the original behaviour.
+ * str_underruns counts the times playback fell back to dummy_data and
+ * str_underrun_blocks the number of silent blocks written meanwhile.
+ */
+int str_preroll = 0;
+int str_blocks;
+int str_underruns;
+int str_underrun_blocks;
+int str_min_ahead;
+#endif
+
 void StrFadeIn(unsigned int fade_speed)
 {
     str_fadein_time = str_volume / fade_speed;
@@ -223,6 +240,9 @@ int StrSpuTransWithNoLoop(void)
     int          result;
     int          bVar1;
     u_long       start_addr;
+#ifdef DEV_EXE
+    int          ahead;
+#endif
 
     result = 0;
 
@@ -246,6 +266,20 @@ int StrSpuTransWithNoLoop(void)
                 SpuSetReverbVoice(SPU_OFF, SPU_21CH | SPU_22CH);
             }
 
+#ifdef DEV_EXE
+            if (str_preroll > 0 &&
+                FS_StreamCountData(1) < str_preroll &&
+                !FS_StreamGetEndFlag() && !FS_StreamIsForceStop())
+            {
+                break;
+            }
+
+            str_blocks = 0;
+            str_underruns = 0;
+            str_underrun_blocks = 0;
+            str_min_ahead = 0x7FFFFFFF;
+#endif
+
             str_data_ptr = FS_StreamGetData(1);
 
             if (str_data_ptr)
@@ -353,7 +387,11 @@ int StrSpuTransWithNoLoop(void)
         attr.sl = 0xf;
         attr.pitch = str_freq;
         attr.addr = spu_bgm_start_ptr_r;
+#ifdef DEV_EXE
+        sd_soft_set_voice_attr(&attr);
+#else
         SpuSetVoiceAttr(&attr);
+#endif
 
         attr.mask = SPU_VOICE_VOLL | SPU_VOICE_VOLR | SPU_VOICE_PITCH | SPU_VOICE_WDSA |
                     SPU_VOICE_ADSR_AMODE | SPU_VOICE_ADSR_SMODE | SPU_VOICE_ADSR_RMODE | SPU_VOICE_ADSR_AR |
@@ -371,7 +409,11 @@ int StrSpuTransWithNoLoop(void)
         attr.sl = 0xf;
         attr.pitch = (u_short)str_freq;
         attr.addr = spu_bgm_start_ptr_l;
+#ifdef DEV_EXE
+        sd_soft_set_voice_attr(&attr);
+#else
         SpuSetVoiceAttr(&attr);
+#endif
 
         dword_800BF270 = 0;
         keyOn(SPU_21CH | SPU_22CH);
@@ -522,10 +564,30 @@ int StrSpuTransWithNoLoop(void)
                     dword_8009F7B8 = str_data_ptr;
                     str_data_ptr = FS_StreamGetData(1);
                     str_play_offset = 0;
+
+#ifdef DEV_EXE
+                    // blocks still queued behind the one just taken
+                    ahead = FS_StreamCountData(1);
+                    if (ahead < str_min_ahead)
+                    {
+                        str_min_ahead = ahead;
+                    }
+#endif
                 }
+
+#ifdef DEV_EXE
+                str_blocks++;
+#endif
             }
             else
             {
+#ifdef DEV_EXE
+                if (str_mute_fg == 0)
+                {
+                    str_underruns++;
+                }
+                str_underrun_blocks++;
+#endif
                 str_mute_fg = 1;
                 printf("*");
 
@@ -598,16 +660,29 @@ int StrSpuTransWithNoLoop(void)
             attr.mask = SPU_VOICE_ADSR_RR;
             attr.voice = SPU_21CH;
             attr.rr = 8;
+#ifdef DEV_EXE
+            sd_soft_set_voice_attr(&attr);
+#else
             SpuSetVoiceAttr(&attr);
+#endif
 
             attr.mask = SPU_VOICE_ADSR_RR;
             attr.voice = SPU_22CH;
             attr.rr = 8;
+#ifdef DEV_EXE
+            sd_soft_set_voice_attr(&attr);
+#else
             SpuSetVoiceAttr(&attr);
+#endif
 
             keyOff(SPU_21CH | SPU_22CH);
             str_tick_count = -1;
             str_status++;
+
+#ifdef DEV_EXE
+            printf("str: blocks %d underruns %d (%d blocks) min ahead %d\n",
+                   str_blocks, str_underruns, str_underrun_blocks, str_min_ahead);
+#endif
         }
         else
         {
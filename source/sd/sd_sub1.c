@@ -290,6 +290,7 @@ void adsr_reset(void)
 {
     spu_tr_wk[mtrack].rr = sptr->rrd;
     spu_tr_wk[mtrack].env3_fg = 1;
+    SD_SET_DIRTY(mtrack);
 }
 
 void note_compute(void)
@@ -334,6 +335,7 @@ void note_compute(void)
 
     spu_tr_wk[mtrack].rr = sptr->rrd;
     spu_tr_wk[mtrack].env3_fg = 1;
+    SD_SET_DIRTY(mtrack);
 
     sptr->swpc = sptr->swsc;
 
@@ -474,6 +476,7 @@ void key_cut_off(void)
     {
         spu_tr_wk[mtrack].rr = 7;
         spu_tr_wk[mtrack].env3_fg = 1;
+        SD_SET_DIRTY(mtrack);
     }
 }
 
@@ -492,6 +495,7 @@ void keych(void)
     {
         spu_tr_wk[mtrack].rr = 7;
         spu_tr_wk[mtrack].env3_fg = 1;
+        SD_SET_DIRTY(mtrack);
     }
 
     if (sptr->ngo)
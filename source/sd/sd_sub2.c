@@ -403,6 +403,7 @@ void ads_set(void)
     spu_tr_wk[mtrack].dr = ~mdata3 & 0xF;
     spu_tr_wk[mtrack].sl = mdata4 & 0xF;
     spu_tr_wk[mtrack].env1_fg = 1;
+    SD_SET_DIRTY(mtrack);
 }
 
 void srs_set(void)
@@ -410,6 +411,7 @@ void srs_set(void)
     spu_tr_wk[mtrack].s_mode = 3;
     spu_tr_wk[mtrack].sr = ~mdata2 & 0x7F;
     spu_tr_wk[mtrack].env2_fg = 1;
+    SD_SET_DIRTY(mtrack);
 }
 
 void rrs_set(void)
@@ -419,6 +421,7 @@ void rrs_set(void)
     spu_tr_wk[mtrack].rr = flags;
     sptr->rrd = flags;
     spu_tr_wk[mtrack].env3_fg = 1;
+    SD_SET_DIRTY(mtrack);
 }
 
 void pm_set(void)